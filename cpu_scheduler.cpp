@@ -2,12 +2,46 @@
 #include <vector>
 #include <algorithm>
 #include <queue>
+#include <deque>
+#include <map>
 #include <iomanip>
 #include <string>
 #include <limits>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <type_traits>
+#include <fstream>
+#include <cmath>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#include <intrin.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+typedef long long SimTime;
 
 struct Process {
     int id;
+    int arrivalTime;
     int burstTime;
     int priority;
     int deadline;
@@ -18,20 +52,751 @@ struct Process {
     bool isRealTime;
     double powerConsumption;
 
-    Process(int processId, int bt, int prio = 128, int dl = 0, bool rt = false)
-        : id(processId), burstTime(bt), priority(prio), deadline(dl), waitingTime(0),
+    Process(int processId, int bt, int prio = 128, int dl = 0, bool rt = false, int at = 0)
+        : id(processId), arrivalTime(at), burstTime(bt), priority(prio), deadline(dl), waitingTime(0),
           turnaroundTime(0), remainingTime(bt), coreId(-1), isRealTime(rt),
           powerConsumption(bt * 0.1) {}
 };
 
+// A column either owns its values or borrows them from memory kept alive by the owning ProcessTable.
+template <typename T>
+class Column {
+private:
+    std::vector<T> owned;
+    const T *borrowed = nullptr;
+    size_t borrowedCount = 0;
+
+public:
+    const T *data() const { return borrowed ? borrowed : owned.data(); }
+    size_t size() const { return borrowed ? borrowedCount : owned.size(); }
+    const T &operator[](size_t i) const { return data()[i]; }
+    const T *begin() const { return data(); }
+    const T *end() const { return data() + size(); }
+
+    void reserve(size_t n) { owned.reserve(n); }
+
+    // Writing to a borrowed column first copies it into owned storage.
+    void push_back(const T &value) {
+        if (borrowed) {
+            owned.assign(borrowed, borrowed + borrowedCount);
+            borrowed = nullptr;
+            borrowedCount = 0;
+        }
+        owned.push_back(value);
+    }
+
+    void clear() {
+        owned.clear();
+        borrowed = nullptr;
+        borrowedCount = 0;
+    }
+
+    void borrow(const T *values, size_t count) {
+        owned.clear();
+        borrowed = values;
+        borrowedCount = count;
+    }
+};
+
+// Column-per-field workload storage; the scheduling loops touch only the columns they need.
+// Runs never write to it: per-run state lives in ScheduleResult.
+struct ProcessTable {
+    Column<int32_t> id;
+    Column<int32_t> arrivalTime;
+    Column<int32_t> burstTime;
+    Column<int32_t> priority;
+    Column<int32_t> deadline;
+    Column<unsigned char> isRealTime;
+    Column<double> powerConsumption;
+    std::shared_ptr<const void> storage;
+
+    size_t size() const { return id.size(); }
+    bool empty() const { return id.size() == 0; }
+
+    void reserve(size_t n) {
+        id.reserve(n); arrivalTime.reserve(n); burstTime.reserve(n); priority.reserve(n);
+        deadline.reserve(n); isRealTime.reserve(n); powerConsumption.reserve(n);
+    }
+
+    void clear() {
+        id.clear(); arrivalTime.clear(); burstTime.clear(); priority.clear();
+        deadline.clear(); isRealTime.clear(); powerConsumption.clear();
+        storage.reset();
+    }
+
+    void push_back(const Process &p) {
+        id.push_back(p.id); arrivalTime.push_back(p.arrivalTime); burstTime.push_back(p.burstTime);
+        priority.push_back(p.priority); deadline.push_back(p.deadline); isRealTime.push_back(p.isRealTime);
+        powerConsumption.push_back(p.powerConsumption);
+    }
+
+    Process row(size_t i) const {
+        Process p(id[i], burstTime[i], priority[i], deadline[i], isRealTime[i] != 0, arrivalTime[i]);
+        p.powerConsumption = powerConsumption[i];
+        return p;
+    }
+};
+
+// Binary workload: a 24-byte header ("CPUSCHW1", u32 version, u32 reserved, u64 count) followed by
+// little-endian columns id, arrival, burst, priority, deadline (int32), power (float64) and
+// realtime (uint8), each starting on an 8-byte boundary so the table can point straight into a mapping.
+const char kWorkloadMagic[8] = {'C', 'P', 'U', 'S', 'C', 'H', 'W', '1'};
+const uint32_t kWorkloadVersion = 1;
+const size_t kWorkloadHeaderSize = 24;
+
+inline size_t alignTo8(size_t offset) { return (offset + 7) & ~static_cast<size_t>(7); }
+
+struct WorkloadLayout {
+    size_t id, arrivalTime, burstTime, priority, deadline, powerConsumption, isRealTime, total;
+
+    explicit WorkloadLayout(size_t count) {
+        size_t ints = alignTo8(count * sizeof(int32_t));
+        id = kWorkloadHeaderSize;
+        arrivalTime = id + ints;
+        burstTime = arrivalTime + ints;
+        priority = burstTime + ints;
+        deadline = priority + ints;
+        powerConsumption = deadline + ints;
+        isRealTime = powerConsumption + count * sizeof(double);
+        total = isRealTime + alignTo8(count);
+    }
+};
+
+inline bool hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char *>(&probe) == 1;
+}
+
+template <typename T>
+T readLittleEndian(const unsigned char *bytes) {
+    typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type bits = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) bits |= static_cast<decltype(bits)>(bytes[i]) << (8 * i);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void writeLittleEndian(std::FILE *file, const Column<T> &column) {
+    if (hostIsLittleEndian()) {
+        std::fwrite(column.data(), sizeof(T), column.size(), file);
+    } else {
+        for (const T &value : column) {
+            typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type bits;
+            std::memcpy(&bits, &value, sizeof(T));
+            for (size_t i = 0; i < sizeof(T); ++i) std::fputc(static_cast<int>((bits >> (8 * i)) & 0xff), file);
+        }
+    }
+    for (size_t pad = column.size() * sizeof(T); pad % 8 != 0; ++pad) std::fputc(0, file);
+}
+
+class MappedFile {
+private:
+    const unsigned char *bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    std::vector<unsigned char> buffer;
+#endif
+
+public:
+    explicit MappedFile(const std::string &path) {
+#ifdef _WIN32
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file) throw std::runtime_error("cannot open " + path);
+        std::fseek(file, 0, SEEK_END);
+        buffer.resize(static_cast<size_t>(std::ftell(file)));
+        std::fseek(file, 0, SEEK_SET);
+        size_t got = std::fread(buffer.data(), 1, buffer.size(), file);
+        std::fclose(file);
+        if (got != buffer.size()) throw std::runtime_error("short read on " + path);
+        bytes = buffer.data();
+        length = buffer.size();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            ::madvise(mapping, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const unsigned char *>(mapping);
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (bytes) ::munmap(const_cast<unsigned char *>(bytes), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char *data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+bool isBinaryWorkload(const std::string &path) {
+    char magic[sizeof(kWorkloadMagic)] = {};
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) throw std::runtime_error("cannot open " + path);
+    size_t got = std::fread(magic, 1, sizeof(magic), file);
+    std::fclose(file);
+    return got == sizeof(magic) && std::memcmp(magic, kWorkloadMagic, sizeof(magic)) == 0;
+}
+
+// The problem with a workload row, or nullptr when it is valid; shared by the text and binary loaders.
+const char *workloadRowError(int32_t arrival, int32_t burst, int32_t deadline) {
+    if (burst <= 0) return "burst time must be positive";
+    if (arrival < 0) return "arrival time must not be negative";
+    if (deadline < 0) return "deadline must not be negative";
+    return nullptr;
+}
+
+void validateBinaryRows(const ProcessTable &table, const std::string &path) {
+    for (size_t i = 0; i < table.size(); ++i) {
+        const char *error = workloadRowError(table.arrivalTime[i], table.burstTime[i], table.deadline[i]);
+        if (error) throw std::runtime_error(path + ": process " + std::to_string(i + 1) + ": " + error);
+    }
+}
+
+ProcessTable loadBinaryWorkload(const std::string &path) {
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(path);
+    const unsigned char *bytes = file->data();
+    if (file->size() < kWorkloadHeaderSize || std::memcmp(bytes, kWorkloadMagic, sizeof(kWorkloadMagic)) != 0)
+        throw std::runtime_error(path + " is not a binary workload");
+    if (readLittleEndian<uint32_t>(bytes + 8) != kWorkloadVersion)
+        throw std::runtime_error(path + ": unsupported workload version");
+    uint64_t count = readLittleEndian<uint64_t>(bytes + 16);
+    if (count > std::numeric_limits<size_t>::max() / 32) throw std::runtime_error(path + ": corrupt header");
+    WorkloadLayout layout(static_cast<size_t>(count));
+    if (file->size() < layout.total) throw std::runtime_error(path + ": truncated workload");
+
+    ProcessTable table;
+    size_t n = static_cast<size_t>(count);
+    if (hostIsLittleEndian()) {
+        table.id.borrow(reinterpret_cast<const int32_t *>(bytes + layout.id), n);
+        table.arrivalTime.borrow(reinterpret_cast<const int32_t *>(bytes + layout.arrivalTime), n);
+        table.burstTime.borrow(reinterpret_cast<const int32_t *>(bytes + layout.burstTime), n);
+        table.priority.borrow(reinterpret_cast<const int32_t *>(bytes + layout.priority), n);
+        table.deadline.borrow(reinterpret_cast<const int32_t *>(bytes + layout.deadline), n);
+        table.powerConsumption.borrow(reinterpret_cast<const double *>(bytes + layout.powerConsumption), n);
+        table.isRealTime.borrow(bytes + layout.isRealTime, n);
+        table.storage = file;
+        validateBinaryRows(table, path);
+        return table;
+    }
+    table.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        table.id.push_back(readLittleEndian<int32_t>(bytes + layout.id + 4 * i));
+        table.arrivalTime.push_back(readLittleEndian<int32_t>(bytes + layout.arrivalTime + 4 * i));
+        table.burstTime.push_back(readLittleEndian<int32_t>(bytes + layout.burstTime + 4 * i));
+        table.priority.push_back(readLittleEndian<int32_t>(bytes + layout.priority + 4 * i));
+        table.deadline.push_back(readLittleEndian<int32_t>(bytes + layout.deadline + 4 * i));
+        table.powerConsumption.push_back(readLittleEndian<double>(bytes + layout.powerConsumption + 8 * i));
+        table.isRealTime.push_back(bytes[layout.isRealTime + i]);
+    }
+    validateBinaryRows(table, path);
+    return table;
+}
+
+void saveBinaryWorkload(const ProcessTable &table, const std::string &path) {
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) throw std::runtime_error("cannot create " + path);
+    unsigned char header[kWorkloadHeaderSize] = {};
+    std::memcpy(header, kWorkloadMagic, sizeof(kWorkloadMagic));
+    uint64_t fields[2] = {kWorkloadVersion, static_cast<uint64_t>(table.size())};
+    for (size_t i = 0; i < 4; ++i) header[8 + i] = static_cast<unsigned char>(fields[0] >> (8 * i));
+    for (size_t i = 0; i < 8; ++i) header[16 + i] = static_cast<unsigned char>(fields[1] >> (8 * i));
+    std::fwrite(header, 1, sizeof(header), file);
+    writeLittleEndian(file, table.id);
+    writeLittleEndian(file, table.arrivalTime);
+    writeLittleEndian(file, table.burstTime);
+    writeLittleEndian(file, table.priority);
+    writeLittleEndian(file, table.deadline);
+    writeLittleEndian(file, table.powerConsumption);
+    std::fwrite(table.isRealTime.data(), 1, table.size(), file);
+    for (size_t pad = table.size(); pad % 8 != 0; ++pad) std::fputc(0, file);
+    bool failed = std::ferror(file) != 0;
+    if (std::fclose(file) != 0 || failed) throw std::runtime_error("error writing " + path);
+}
+
+// Parses an optionally signed decimal integer in [p, end) and advances p past it.
+inline bool parseInt32(const char *&p, const char *end, int32_t &value) {
+    bool negative = p < end && *p == '-';
+    if (negative || (p < end && *p == '+')) ++p;
+    if (p == end || *p < '0' || *p > '9') return false;
+    int64_t result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p++ - '0');
+        if (result > static_cast<int64_t>(std::numeric_limits<int32_t>::max()) + 1) return false;
+    }
+    result = negative ? -result : result;
+    if (result > std::numeric_limits<int32_t>::max()) return false;
+    value = static_cast<int32_t>(result);
+    return true;
+}
+
+enum class WorkloadField { Id, Arrival, Burst, Priority, Deadline, RealTime, Ignored };
+
+WorkloadField workloadFieldNamed(std::string name) {
+    for (auto &c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    name.erase(std::remove_if(name.begin(), name.end(), [](char c) { return c == '_' || c == ' ' || c == '\r'; }),
+               name.end());
+    if (name == "id" || name == "pid" || name == "process") return WorkloadField::Id;
+    if (name == "arrival" || name == "arrivaltime") return WorkloadField::Arrival;
+    if (name == "burst" || name == "bursttime") return WorkloadField::Burst;
+    if (name == "priority") return WorkloadField::Priority;
+    if (name == "deadline") return WorkloadField::Deadline;
+    if (name == "realtime" || name == "isrealtime" || name == "rt") return WorkloadField::RealTime;
+    return WorkloadField::Ignored;
+}
+
+// Streams a CSV or TSV workload through a fixed read buffer. Columns default to
+// id,arrival,burst,priority,deadline,realtime unless the first line is a header naming them.
+class DelimitedWorkloadParser {
+private:
+    ProcessTable &table;
+    std::string path;
+    std::vector<WorkloadField> fields;
+    char delimiter = 0;
+    size_t lineNumber = 0;
+    bool sawFirstLine = false;
+
+    [[noreturn]] void fail(const std::string &message) const {
+        throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + message);
+    }
+
+    void parseHeaderOrDefault(const char *begin, const char *end) {
+        delimiter = std::find(begin, end, '\t') != end ? '\t' : ',';
+        const char *p = begin;
+        while (p < end && (*p == ' ' || *p == '"')) ++p;
+        bool header = p < end && !(*p >= '0' && *p <= '9') && *p != '-' && *p != '+';
+        if (header) {
+            const char *cell = begin;
+            while (cell <= end) {
+                const char *stop = std::find(cell, end, delimiter);
+                std::string name(cell, stop);
+                name.erase(std::remove(name.begin(), name.end(), '"'), name.end());
+                fields.push_back(workloadFieldNamed(name));
+                cell = stop + 1;
+            }
+            if (std::find(fields.begin(), fields.end(), WorkloadField::Burst) == fields.end())
+                fail("header has no burst column");
+        } else {
+            fields = {WorkloadField::Id, WorkloadField::Arrival, WorkloadField::Burst,
+                      WorkloadField::Priority, WorkloadField::Deadline, WorkloadField::RealTime};
+        }
+        sawFirstLine = true;
+        if (!header) parseRow(begin, end);
+    }
+
+    void parseRow(const char *p, const char *end) {
+        int32_t values[6] = {static_cast<int32_t>(table.size() + 1), 0, -1, 128, 0, 0};
+        for (size_t column = 0; column < fields.size() && p <= end; ++column) {
+            while (p < end && *p == ' ') ++p;
+            WorkloadField field = fields[column];
+            if (field == WorkloadField::RealTime) {
+                if (p < end) {
+                    char flag = *p;
+                    values[5] = (flag == 'y' || flag == 'Y' || flag == '1' || flag == 't' || flag == 'T') ? 1 : 0;
+                }
+                p = std::find(p, end, delimiter);
+            } else if (field == WorkloadField::Ignored || p == end || *p == delimiter) {
+                p = std::find(p, end, delimiter);
+            } else if (!parseInt32(p, end, values[static_cast<int>(field)])) {
+                fail("expected an integer in column " + std::to_string(column + 1));
+            } else {
+                while (p < end && (*p == ' ' || *p == '\r')) ++p;
+                if (p < end && *p != delimiter) fail("unexpected text in column " + std::to_string(column + 1));
+            }
+            ++p;
+        }
+        if (const char *error = workloadRowError(values[1], values[2], values[4])) fail(error);
+        table.id.push_back(values[0]);
+        table.arrivalTime.push_back(values[1]);
+        table.burstTime.push_back(values[2]);
+        table.priority.push_back(values[3]);
+        table.deadline.push_back(values[4]);
+        table.isRealTime.push_back(static_cast<unsigned char>(values[5]));
+        table.powerConsumption.push_back(values[2] * 0.1);
+    }
+
+    void parseLine(const char *begin, const char *end) {
+        ++lineNumber;
+        if (end > begin && end[-1] == '\r') --end;
+        if (begin == end || *begin == '#') return;
+        if (!sawFirstLine) parseHeaderOrDefault(begin, end);
+        else parseRow(begin, end);
+    }
+
+public:
+    DelimitedWorkloadParser(ProcessTable &target, const std::string &source) : table(target), path(source) {}
+
+    void parse() {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file) throw std::runtime_error("cannot open " + path);
+        std::unique_ptr<std::FILE, int (*)(std::FILE *)> closer(file, std::fclose);
+        const size_t bufferSize = 4 << 20;
+        std::vector<char> buffer(bufferSize);
+        size_t carried = 0;
+        while (true) {
+            size_t got = std::fread(buffer.data() + carried, 1, buffer.size() - carried, file);
+            size_t filled = carried + got;
+            if (got == 0) {
+                if (carried > 0) parseLine(buffer.data(), buffer.data() + carried);
+                break;
+            }
+            const char *lineStart = buffer.data();
+            const char *bufferEnd = buffer.data() + filled;
+            const char *newline;
+            while ((newline = static_cast<const char *>(std::memchr(lineStart, '\n', bufferEnd - lineStart)))) {
+                parseLine(lineStart, newline);
+                lineStart = newline + 1;
+            }
+            carried = bufferEnd - lineStart;
+            // A line filling the whole buffer starts at offset 0 and stays put; resize() may move the buffer.
+            size_t offset = lineStart - buffer.data();
+            if (carried == buffer.size()) buffer.resize(buffer.size() * 2);
+            if (offset > 0) std::memmove(buffer.data(), buffer.data() + offset, carried);
+        }
+        if (std::ferror(file)) throw std::runtime_error("error reading " + path);
+    }
+};
+
+ProcessTable loadWorkloadFile(const std::string &path) {
+    if (isBinaryWorkload(path)) return loadBinaryWorkload(path);
+    ProcessTable table;
+    DelimitedWorkloadParser(table, path).parse();
+    return table;
+}
+
+// Report text is formatted into one reusable buffer and handed to the OS with a single write(2) per chunk.
+// iostream formatting with a flush per line costs more than scheduling once tables reach millions of rows.
+class ReportWriter {
+private:
+    static const size_t kChunkSize = 1 << 20;
+
+    int fd;
+    bool ownsFd = false;
+    bool failed = false;
+    std::vector<char> buffer;
+    size_t used = 0;
+    unsigned long long flushedBytes = 0;
+    unsigned long long fieldStart = 0;
+
+    void reserve(size_t bytes) {
+        if (buffer.size() - used < bytes) flush();
+    }
+
+    static long writeSome(int fd, const char *data, size_t length) {
+#ifdef _WIN32
+        return ::_write(fd, data, static_cast<unsigned>(std::min<size_t>(length, 1u << 30)));
+#else
+        return static_cast<long>(::write(fd, data, length));
+#endif
+    }
+
+public:
+    // Writes to standard output. Anything still buffered in std::cout goes out first so the two stay in order.
+    ReportWriter() : fd(1), buffer(kChunkSize) {
+        std::cout.flush();
+    }
+
+    explicit ReportWriter(const std::string &path) : buffer(kChunkSize) {
+#ifdef _WIN32
+        fd = ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+        if (fd < 0) throw std::runtime_error("cannot create " + path);
+        ownsFd = true;
+    }
+
+    ~ReportWriter() {
+        flush();
+#ifdef _WIN32
+        if (ownsFd) ::_close(fd);
+#else
+        if (ownsFd) ::close(fd);
+#endif
+    }
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    bool good() const { return !failed; }
+
+    void flush() {
+        size_t done = 0;
+        while (done < used && !failed) {
+            long written = writeSome(fd, buffer.data() + done, used - done);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) failed = true;
+            else done += static_cast<size_t>(written);
+        }
+        flushedBytes += used;
+        used = 0;
+    }
+
+    ReportWriter &put(char c) {
+        reserve(1);
+        buffer[used++] = c;
+        return *this;
+    }
+
+    ReportWriter &repeat(char c, size_t count) {
+        if (count <= buffer.size() - used) {
+            std::memset(buffer.data() + used, c, count);
+            used += count;
+            return *this;
+        }
+        while (count > 0) {
+            reserve(1);
+            size_t n = std::min(count, buffer.size() - used);
+            std::memset(buffer.data() + used, c, n);
+            used += n;
+            count -= n;
+        }
+        return *this;
+    }
+
+    ReportWriter &text(const char *data, size_t length) {
+        if (length <= buffer.size() - used) {
+            std::memcpy(buffer.data() + used, data, length);
+            used += length;
+            return *this;
+        }
+        while (length > 0) {
+            reserve(1);
+            size_t n = std::min(length, buffer.size() - used);
+            std::memcpy(buffer.data() + used, data, n);
+            used += n;
+            data += n;
+            length -= n;
+        }
+        return *this;
+    }
+
+    ReportWriter &text(const char *s) { return text(s, std::strlen(s)); }
+    ReportWriter &text(const std::string &s) { return text(s.data(), s.size()); }
+
+    // Characters integer(value) writes, sign included.
+    static size_t integerLength(long long value) {
+        unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                                 : static_cast<unsigned long long>(value);
+        size_t length = value < 0 ? 2 : 1;
+        for (unsigned long long bound = 10; magnitude >= bound; bound *= 10) {
+            ++length;
+            if (bound > std::numeric_limits<unsigned long long>::max() / 10) break;
+        }
+        return length;
+    }
+
+    // Hand-rolled std::to_chars: digits are counted first, then written backwards in place two at a time.
+    ReportWriter &integer(long long value) {
+        static const char kDigitPairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        reserve(20);
+        unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                                 : static_cast<unsigned long long>(value);
+        size_t length = integerLength(value);
+        if (value < 0) buffer[used] = '-';
+        used += length;
+        char *p = buffer.data() + used;
+        while (magnitude >= 100) {
+            unsigned pair = static_cast<unsigned>(magnitude % 100) * 2;
+            magnitude /= 100;
+            *--p = kDigitPairs[pair + 1];
+            *--p = kDigitPairs[pair];
+        }
+        if (magnitude >= 10) {
+            *--p = kDigitPairs[magnitude * 2 + 1];
+            *--p = kDigitPairs[magnitude * 2];
+        } else {
+            *--p = static_cast<char>('0' + magnitude);
+        }
+        return *this;
+    }
+
+    // Matches std::fixed << std::setprecision(precision). Below 1e9 the product's rounding error is far
+    // under the 1e-6 tie margin; anything else goes through snprintf so the digits match iostream output.
+    ReportWriter &fixed(double value, int precision) {
+        static const double kScale[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+        precision = std::max(precision, 0);
+        bool fast = precision <= 6;
+        double scaled = fast ? std::fabs(value) * kScale[precision] : 0.0;
+        if (!fast || !(scaled < 1e9) || std::fabs(scaled - std::floor(scaled) - 0.5) < 1e-6) {
+            char formatted[512];
+            int length = std::snprintf(formatted, sizeof(formatted), "%.*f", precision, value);
+            return text(formatted, static_cast<size_t>(std::max(length, 0)));
+        }
+        unsigned long long units = static_cast<unsigned long long>(scaled + 0.5);
+        unsigned long long scale = static_cast<unsigned long long>(kScale[precision]);
+        if (std::signbit(value)) put('-');
+        integer(static_cast<long long>(units / scale));
+        if (precision == 0) return *this;
+        char digits[8];
+        for (int i = precision - 1; i >= 0; --i) {
+            digits[i] = static_cast<char>('0' + units % 10);
+            units /= 10;
+        }
+        put('.');
+        return text(digits, static_cast<size_t>(precision));
+    }
+
+    // field() ... pad(width) left-aligns what was written in between, like std::left << std::setw(width).
+    ReportWriter &field() {
+        fieldStart = flushedBytes + used;
+        return *this;
+    }
+
+    ReportWriter &pad(size_t width) {
+        unsigned long long length = flushedBytes + used - fieldStart;
+        if (length < width) repeat(' ', static_cast<size_t>(width - length));
+        return *this;
+    }
+};
+
+inline int highestSetBit(unsigned long long bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(bits);
+#endif
+}
+
+// Log-linear histogram of non-negative times, as in HDR Histogram: values below 2^kSubBucketBits get a bucket
+// each, and every further power of two is split into 2^(kSubBucketBits - 1) buckets, so quantiles are exact for
+// small values and within 0.4% above. Recording is O(1), memory grows with the log of the largest value, and
+// histograms from separate runs merge by adding counts.
+class LatencyHistogram {
+private:
+    static const int kSubBucketBits = 8;
+    std::vector<unsigned long long> counts;
+    unsigned long long total = 0;
+
+    static size_t bucketOf(SimTime value) {
+        if (value < (1 << kSubBucketBits)) return static_cast<size_t>(value);
+        int shift = highestSetBit(static_cast<unsigned long long>(value)) - (kSubBucketBits - 1);
+        return (static_cast<size_t>(shift) << (kSubBucketBits - 1)) + static_cast<size_t>(value >> shift);
+    }
+
+    // Midpoint of the values that share the bucket.
+    static SimTime valueOf(size_t bucket) {
+        if (bucket < (1u << kSubBucketBits)) return static_cast<SimTime>(bucket);
+        int shift = static_cast<int>(bucket >> (kSubBucketBits - 1)) - 1;
+        SimTime low = static_cast<SimTime>(bucket - (static_cast<size_t>(shift) << (kSubBucketBits - 1))) << shift;
+        return low + ((SimTime(1) << shift) - 1) / 2;
+    }
+
+public:
+    void record(SimTime value) {
+        size_t bucket = bucketOf(std::max<SimTime>(0, value));
+        if (bucket >= counts.size()) counts.resize(bucket + 1, 0);
+        counts[bucket]++;
+        total++;
+    }
+
+    void merge(const LatencyHistogram &other) {
+        if (other.counts.size() > counts.size()) counts.resize(other.counts.size(), 0);
+        for (size_t i = 0; i < other.counts.size(); ++i) counts[i] += other.counts[i];
+        total += other.total;
+    }
+
+    unsigned long long count() const { return total; }
+
+    // Nearest-rank quantile, 0 when nothing was recorded.
+    SimTime quantile(double q) const {
+        if (total == 0) return 0;
+        unsigned long long rank = std::max<unsigned long long>(1, static_cast<unsigned long long>(std::ceil(q * total)));
+        unsigned long long seen = 0;
+        for (size_t bucket = 0; bucket < counts.size(); ++bucket) {
+            seen += counts[bucket];
+            if (seen >= rank) return valueOf(bucket);
+        }
+        return valueOf(counts.size() - 1);
+    }
+};
+
+// Priorities 0-255 fall into four bands of 64, highest priority (lowest value) first.
+struct PriorityBand {
+    static const int kCount = 4;
+
+    long long processes = 0;
+    double totalWaiting = 0.0;
+    double totalSlowdown = 0.0;
+    SimTime maxWaiting = 0;
+    LatencyHistogram waitingTimes;
+
+    static int of(int priority) { return std::min(255, std::max(0, priority)) / 64; }
+    double averageWaiting() const { return processes ? totalWaiting / processes : 0.0; }
+    double averageSlowdown() const { return processes ? totalSlowdown / processes : 0.0; }
+};
+
 struct SystemMetrics {
     double totalPowerConsumption = 0.0;
     double averagePowerPerCore = 0.0;
     int deadlineMisses = 0;
     int totalProcesses = 0;
     double throughput = 0.0;
+    SimTime makespan = 0;
+    double averageWaitingTime = 0.0;
+    double averageTurnaroundTime = 0.0;
+    // Response time runs from arrival to first dispatch.
+    double averageResponseTime = 0.0;
+    LatencyHistogram waitingTimes;
+    LatencyHistogram turnaroundTimes;
+    LatencyHistogram responseTimes;
+    // Slowdown is turnaround / burst; bounded slowdown divides by at least FairnessConfig::slowdownBound and is
+    // at least 1, so tiny jobs do not dominate.
+    double averageSlowdown = 0.0;
+    double maxSlowdown = 0.0;
+    double averageBoundedSlowdown = 0.0;
+    // Jain's fairness index of the slowdowns: 1 when all processes are slowed down alike, down to 1/n.
+    double fairnessIndex = 0.0;
+    // The longest wait, and the processes that waited at least FairnessConfig::starvationWait.
+    SimTime maxWaitingTime = 0;
+    long long starvedProcesses = 0;
+    PriorityBand priorityBands[PriorityBand::kCount];
+    // Processes that waited while a lower-priority process ran, and the total time they spent doing so.
+    int priorityInversions = 0;
+    SimTime priorityInversionTime = 0;
+    // Times a core went on to run a different process than the one it ran last.
+    long long contextSwitches = 0;
+    // Work stealing: steals, the processes they moved, and the time cores spent on them.
+    long long steals = 0;
+    long long stolenProcesses = 0;
+    SimTime stealOverhead = 0;
+    // Slices that began on another core than their process last ran on, and the time cores lost to context
+    // switch costs and to migration and cache refill penalties.
+    long long migrations = 0;
+    SimTime switchOverhead = 0;
+    SimTime migrationOverhead = 0;
+    // Time charged for running away from the NUMA node a process's memory lives on.
+    SimTime numaOverhead = 0;
+    // Busy-time weighted core frequency, in percent of full speed.
+    double averageFrequency = 0.0;
+    // Wakeups from an idle state, and the time their exit latencies delayed work.
+    long long wakeups = 0;
+    SimTime wakeupLatency = 0;
 
-    void calculateMetrics(int numCores, int totalTime) {
+    void calculateMetrics(int numCores, SimTime totalTime) {
+        makespan = totalTime;
         if (numCores > 0)
             averagePowerPerCore = totalPowerConsumption / numCores;
         if (totalTime > 0)
@@ -39,303 +804,3572 @@ struct SystemMetrics {
     }
 };
 
-class EnhancedCPUScheduler {
+struct GanttSlice {
+    int processId;
+    SimTime start;
+    SimTime duration;
+};
+
+// Per-core timeline stored as varint records. Each record starts with (gap since the previous record's end << 1 | isCycle);
+// a run then holds the zigzagged process id and duration, a cycle holds its length, slice, rounds and process ids.
+// Idle time is implicit in the gaps, and contiguous slices of the same process are merged before encoding.
+class GanttTrack {
 private:
-    std::vector<Process> processes;
-    std::vector<std::vector<std::pair<int, int>>> ganttCharts;
-    int numCores;
-    SystemMetrics metrics;
+    std::vector<unsigned char> bytes;
+    SimTime encodedEnd = 0;
+    bool hasOpenRun = false;
+    GanttSlice openRun = GanttSlice{0, 0, 0};
+
+    void putVarint(unsigned long long value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<unsigned char>(value));
+    }
+
+    static unsigned long long getVarint(const std::vector<unsigned char> &data, size_t &offset) {
+        unsigned long long value = 0;
+        int shift = 0;
+        while (data[offset] & 0x80) {
+            value |= static_cast<unsigned long long>(data[offset++] & 0x7f) << shift;
+            shift += 7;
+        }
+        return value | static_cast<unsigned long long>(data[offset++]) << shift;
+    }
+
+    static unsigned long long zigzag(int value) {
+        return (static_cast<unsigned long long>(value) << 1) ^ static_cast<unsigned long long>(value < 0 ? -1 : 0);
+    }
+
+    static int unzigzag(unsigned long long value) {
+        return static_cast<int>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    void putHeader(SimTime start, bool isCycle) {
+        putVarint(static_cast<unsigned long long>(start - encodedEnd) << 1 | (isCycle ? 1 : 0));
+    }
+
+    void flushOpenRun() {
+        if (!hasOpenRun) return;
+        putHeader(openRun.start, false);
+        putVarint(zigzag(openRun.processId));
+        putVarint(openRun.duration);
+        encodedEnd = openRun.start + openRun.duration;
+        hasOpenRun = false;
+    }
 
 public:
-    EnhancedCPUScheduler(int cores = 4) : numCores(cores) {
-        ganttCharts.resize(numCores);
+    class const_iterator {
+    private:
+        const GanttTrack *track;
+        size_t offset;
+        bool openRunPending;
+        GanttSlice current;
+        SimTime time;
+        size_t cycleIds = 0;
+        size_t cycleLength = 0;
+        size_t cycleIndex = 0;
+        SimTime cycleSlice = 0;
+        SimTime roundsLeft = 0;
+        size_t cycleCursor = 0;
+        bool atEnd;
+
+        void advance() {
+            const std::vector<unsigned char> &data = track->bytes;
+            if (roundsLeft > 0) {
+                current = GanttSlice{unzigzag(getVarint(data, cycleCursor)), time, cycleSlice};
+                time += cycleSlice;
+                if (++cycleIndex == cycleLength) {
+                    cycleIndex = 0;
+                    cycleCursor = cycleIds;
+                    --roundsLeft;
+                }
+                return;
+            }
+            if (offset < data.size()) {
+                unsigned long long header = getVarint(data, offset);
+                time += static_cast<SimTime>(header >> 1);
+                if (header & 1) {
+                    cycleLength = getVarint(data, offset);
+                    cycleSlice = getVarint(data, offset);
+                    roundsLeft = getVarint(data, offset);
+                    cycleIds = cycleCursor = offset;
+                    for (size_t i = 0; i < cycleLength; ++i) getVarint(data, offset);
+                    cycleIndex = 0;
+                    advance();
+                } else {
+                    int processId = unzigzag(getVarint(data, offset));
+                    SimTime duration = getVarint(data, offset);
+                    current = GanttSlice{processId, time, duration};
+                    time += duration;
+                }
+                return;
+            }
+            if (openRunPending) {
+                openRunPending = false;
+                current = track->openRun;
+                return;
+            }
+            atEnd = true;
+        }
+
+    public:
+        const_iterator(const GanttTrack *owner, bool end)
+            : track(owner), offset(0), openRunPending(owner->hasOpenRun), current(GanttSlice{0, 0, 0}),
+              time(0), atEnd(end) {
+            if (!atEnd) advance();
+        }
+
+        const GanttSlice &operator*() const { return current; }
+        const GanttSlice *operator->() const { return &current; }
+
+        const_iterator &operator++() {
+            advance();
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const {
+            if (atEnd || other.atEnd) return atEnd == other.atEnd;
+            return offset == other.offset && roundsLeft == other.roundsLeft && cycleIndex == other.cycleIndex &&
+                   openRunPending == other.openRunPending;
+        }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    const_iterator begin() const { return const_iterator(this, false); }
+    const_iterator end() const { return const_iterator(this, true); }
+
+    bool empty() const { return bytes.empty() && !hasOpenRun; }
+    SimTime endTime() const { return hasOpenRun ? openRun.start + openRun.duration : encodedEnd; }
+    size_t encodedBytes() const { return bytes.capacity(); }
+
+    void clear() {
+        bytes.clear();
+        encodedEnd = 0;
+        hasOpenRun = false;
+    }
+
+    // Cuts the last appended slice short at `end`, as when its process is preempted.
+    void truncate(SimTime end) {
+        if (!hasOpenRun) return;
+        openRun.duration = end - openRun.start;
+        if (openRun.duration <= 0) hasOpenRun = false;
+    }
+
+    void append(int processId, SimTime start, SimTime duration) {
+        if (hasOpenRun && openRun.processId == processId && openRun.start + openRun.duration == start) {
+            openRun.duration += duration;
+            return;
+        }
+        flushOpenRun();
+        openRun = GanttSlice{processId, start, duration};
+        hasOpenRun = true;
+    }
+
+    // Records `rounds` back-to-back passes over `processIds`, each slice `slice` long.
+    void appendCycle(const std::vector<int> &processIds, SimTime start, SimTime slice, SimTime rounds) {
+        if (processIds.size() == 1) {
+            append(processIds.front(), start, slice * rounds);
+            return;
+        }
+        flushOpenRun();
+        putHeader(start, true);
+        putVarint(processIds.size());
+        putVarint(slice);
+        putVarint(rounds);
+        for (int processId : processIds) putVarint(zigzag(processId));
+        encodedEnd = start + slice * rounds * static_cast<SimTime>(processIds.size());
+    }
+};
+
+// The part of a Gantt chart to draw: the time window [from, to), a subset of cores (empty means all) and the
+// time units per chart cell. Cells wider than one unit are point-sampled at their start time.
+struct GanttView {
+    SimTime from = 0;
+    SimTime to = std::numeric_limits<SimTime>::max();
+    std::vector<int> cores;
+    SimTime timeScale = 1;
+
+    bool showsCore(int core) const {
+        return cores.empty() || std::find(cores.begin(), cores.end(), core) != cores.end();
+    }
+};
+
+// Calls emit(processId, start, end) for each block of the chart in time order, with -1 for idle gaps.
+// Nothing is buffered, so renderers can make one pass per output line in constant memory.
+template <typename Emit>
+void forEachGanttBlock(const GanttTrack &track, const GanttView &view, Emit emit) {
+    SimTime time = view.from;
+    if (view.timeScale <= 1) {
+        for (const GanttSlice &slice : track) {
+            if (slice.start >= view.to) break;
+            SimTime start = std::max(slice.start, view.from);
+            SimTime end = std::min(slice.start + slice.duration, view.to);
+            if (end <= start) continue;
+            if (start > time) emit(-1, time, start);
+            emit(slice.processId, start, end);
+            time = end;
+        }
+        return;
+    }
+
+    SimTime stop = std::min(view.to, track.endTime());
+    GanttTrack::const_iterator slice = track.begin(), last = track.end();
+    SimTime blockStart = time;
+    int blockProcess = -1;
+    for (; time < stop; time += view.timeScale) {
+        while (slice != last && slice->start + slice->duration <= time) ++slice;
+        int processId = slice != last && slice->start <= time ? slice->processId : -1;
+        if (time > blockStart && processId != blockProcess) {
+            emit(blockProcess, blockStart, time);
+            blockStart = time;
+        }
+        blockProcess = processId;
+    }
+    if (time > blockStart) emit(blockProcess, blockStart, time);
+}
+
+enum class Algorithm {
+    FCFS, Priority, EDF, RoundRobin, PreemptivePriority, GlobalEDF, PartitionedEDFFirstFit, PartitionedEDFWorstFit,
+    SRTF, MLFQ, CFS, RoundRobinStealing, EnergyAwareFCFS, EnergyAwareEDF, DvfsEDF, ConsolidatedFCFS
+};
+
+const std::vector<Algorithm> &allAlgorithms() {
+    static const std::vector<Algorithm> algorithms = {
+        Algorithm::FCFS, Algorithm::Priority, Algorithm::EDF, Algorithm::RoundRobin, Algorithm::PreemptivePriority,
+        Algorithm::GlobalEDF, Algorithm::PartitionedEDFFirstFit, Algorithm::PartitionedEDFWorstFit, Algorithm::SRTF,
+        Algorithm::MLFQ, Algorithm::CFS, Algorithm::RoundRobinStealing, Algorithm::EnergyAwareFCFS,
+        Algorithm::EnergyAwareEDF, Algorithm::DvfsEDF, Algorithm::ConsolidatedFCFS};
+    return algorithms;
+}
+
+const char *algorithmName(Algorithm algorithm) {
+    switch (algorithm) {
+        case Algorithm::FCFS: return "Multi-Core FCFS";
+        case Algorithm::Priority: return "Priority-Based Scheduling";
+        case Algorithm::EDF: return "EDF (Earliest Deadline First)";
+        case Algorithm::RoundRobin: return "Multi-Core Round Robin";
+        case Algorithm::PreemptivePriority: return "Preemptive Priority with Aging";
+        case Algorithm::GlobalEDF: return "Global Preemptive EDF";
+        case Algorithm::PartitionedEDFFirstFit: return "Partitioned EDF (First-Fit)";
+        case Algorithm::PartitionedEDFWorstFit: return "Partitioned EDF (Worst-Fit)";
+        case Algorithm::SRTF: return "SRTF (Shortest Remaining Time First)";
+        case Algorithm::MLFQ: return "Multi-Level Feedback Queue";
+        case Algorithm::CFS: return "CFS (Completely Fair Scheduler)";
+        case Algorithm::RoundRobinStealing: return "Round Robin with Work Stealing";
+        case Algorithm::EnergyAwareFCFS: return "Energy-Aware FCFS";
+        case Algorithm::EnergyAwareEDF: return "Energy-Aware EDF";
+        case Algorithm::DvfsEDF: return "EDF with DVFS";
+        case Algorithm::ConsolidatedFCFS: return "Consolidating FCFS";
+    }
+    return "";
+}
+
+const char *algorithmKey(Algorithm algorithm) {
+    switch (algorithm) {
+        case Algorithm::FCFS: return "fcfs";
+        case Algorithm::Priority: return "priority";
+        case Algorithm::EDF: return "edf";
+        case Algorithm::RoundRobin: return "rr";
+        case Algorithm::PreemptivePriority: return "preemptive";
+        case Algorithm::GlobalEDF: return "gedf";
+        case Algorithm::PartitionedEDFFirstFit: return "pedf-ff";
+        case Algorithm::PartitionedEDFWorstFit: return "pedf-wf";
+        case Algorithm::SRTF: return "srtf";
+        case Algorithm::MLFQ: return "mlfq";
+        case Algorithm::CFS: return "cfs";
+        case Algorithm::RoundRobinStealing: return "rr-steal";
+        case Algorithm::EnergyAwareFCFS: return "fcfs-energy";
+        case Algorithm::EnergyAwareEDF: return "edf-energy";
+        case Algorithm::DvfsEDF: return "edf-dvfs";
+        case Algorithm::ConsolidatedFCFS: return "fcfs-pack";
+    }
+    return "";
+}
+
+// What the time parameter means to a policy, or nullptr when the policy ignores it.
+const char *algorithmParameter(Algorithm algorithm) {
+    switch (algorithm) {
+        case Algorithm::RoundRobin:
+        case Algorithm::RoundRobinStealing:
+        case Algorithm::MLFQ: return "quantum";
+        case Algorithm::PreemptivePriority: return "aging interval";
+        case Algorithm::CFS: return "target latency";
+        default: return nullptr;
+    }
+}
+
+struct ScheduleResult {
+    Algorithm algorithm = Algorithm::FCFS;
+    int numCores = 0;
+    int timeQuantum = 0;
+    std::vector<int32_t> remainingTime;
+    std::vector<int32_t> waitingTime;
+    std::vector<int32_t> turnaroundTime;
+    // Time from arrival to first dispatch, -1 until then.
+    std::vector<int32_t> responseTime;
+    std::vector<int32_t> coreId;
+    std::vector<GanttTrack> ganttCharts;
+    // Per core: context switches, and slices of processes that last ran on another core.
+    std::vector<long long> coreSwitches;
+    std::vector<long long> coreMigrations;
+    // Per core: time spent busy, the energy drawn busy and idle until the makespan, and wakeups from idle states.
+    std::vector<SimTime> coreBusyTime;
+    std::vector<double> coreEnergy;
+    std::vector<long long> coreWakeups;
+    // Energy each process drew while running, at its cores' busy power.
+    std::vector<double> energy;
+    bool recordGantt = true;
+    bool tracksPriorityInversion = false;
+    SystemMetrics metrics;
+
+    ScheduleResult() {}
+
+    ScheduleResult(const ProcessTable &processes, int cores)
+        : numCores(cores), remainingTime(processes.burstTime.begin(), processes.burstTime.end()), waitingTime(processes.size(), 0),
+          turnaroundTime(processes.size(), 0), responseTime(processes.size(), -1), coreId(processes.size(), -1), ganttCharts(cores),
+          coreSwitches(cores, 0), coreMigrations(cores, 0), coreBusyTime(cores, 0), coreEnergy(cores, 0.0),
+          coreWakeups(cores, 0), energy(processes.size(), 0.0) {}
+};
+
+// A kind of core: its speed in percent of a reference core, and its power draw when busy and when idle.
+struct CoreClass {
+    std::string name;
+    int speed = 100;
+    double activeWatts = 0.1;
+    double idleWatts = 0.0;
+};
+
+// Core classes in order of first use and the class of each core; runs on n cores use the first n.
+// Without classes every core is a default CoreClass.
+struct CorePlatform {
+    std::vector<CoreClass> classes;
+    std::vector<int> classOf;
+
+    size_t size() const { return classOf.size(); }
+};
+
+// Frequency levels (P-states) of every core, in percent of its class's full speed; 100 is always one of them.
+// At level f a busy core draws activeWatts * (leakage + (1 - leakage) * (f / 100)^3): static leakage plus
+// dynamic power, cubic because voltage scales with frequency.
+struct DvfsConfig {
+    std::vector<int> levels = {100};
+    double leakage = 0.0;
+
+    double busyShare(int level) const {
+        double f = level / 100.0;
+        return leakage + (1 - leakage) * f * f * f;
     }
+};
+
+// An idle state (C-state). A core idle for longer than targetResidency starts entering it, which takes
+// entryLatency at the core's busy power; it then draws watts until it goes deeper or wakes. Waking costs the
+// rest of any entry still under way plus exitLatency, also at busy power.
+struct IdleState {
+    std::string name;
+    double watts = 0.0;
+    SimTime entryLatency = 0;
+    SimTime exitLatency = 0;
+    SimTime targetResidency = 0;
+};
+
+// States from shallowest to deepest, by increasing target residency. Without states an idle core draws its
+// class's idle power and wakes at once.
+struct IdleStateConfig {
+    std::vector<IdleState> states;
+};
+
+// Thresholds for the slowdown and starvation metrics.
+struct FairnessConfig {
+    SimTime slowdownBound = 10;
+    SimTime starvationWait = 1000;
+};
+
+// Time a core loses before a slice can start. A switch to a different process costs contextSwitchCost. A process
+// that last ran on another core pays migrationPenalty to refill a cold cache; back on its own core it pays the
+// part of that its footprint lost while away, which halves every cacheHalfLife time units (0 never decays).
+// With a CPU topology, moving to an SMT sibling is free, leaving the LLC domain adds llcPenalty, and every slice
+// run off the socket a process first ran on adds remoteNumaPenalty for its remote memory.
+struct SwitchCostModel {
+    SimTime contextSwitchCost = 0;
+    SimTime migrationPenalty = 0;
+    SimTime cacheHalfLife = 0;
+    SimTime llcPenalty = 0;
+    SimTime remoteNumaPenalty = 0;
+
+    bool active() const {
+        return contextSwitchCost > 0 || migrationPenalty > 0 || llcPenalty > 0 || remoteNumaPenalty > 0;
+    }
+
+    SimTime refillPenalty(SimTime away) const {
+        if (cacheHalfLife <= 0 || away <= 0) return 0;
+        return static_cast<SimTime>(std::llround(migrationPenalty * (1.0 - std::exp2(-static_cast<double>(away) /
+                                                                                    cacheHalfLife))));
+    }
+};
+
+class CoreHeap {
+private:
+    std::vector<int> heap;
+    std::vector<int> position;
+    std::vector<SimTime> readyTime;
+
+    bool before(int a, int b) const {
+        return readyTime[a] != readyTime[b] ? readyTime[a] < readyTime[b] : a < b;
+    }
+
+    void place(size_t i, int core) {
+        heap[i] = core;
+        position[core] = static_cast<int>(i);
+    }
+
+    void siftUp(size_t i) {
+        int core = heap[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!before(core, heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, core);
+    }
+
+    void siftDown(size_t i) {
+        int core = heap[i];
+        size_t n = heap.size();
+        while (true) {
+            size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && before(heap[child + 1], heap[child])) child++;
+            if (!before(heap[child], core)) break;
+            place(i, heap[child]);
+            i = child;
+        }
+        place(i, core);
+    }
+
+public:
+    explicit CoreHeap(int cores = 0) { reset(cores); }
+
+    void reset(int cores) {
+        heap.resize(cores);
+        position.resize(cores);
+        readyTime.assign(cores, 0);
+        for (int core = 0; core < cores; ++core) place(core, core);
+    }
+
+    bool empty() const { return heap.empty(); }
+    bool contains(int core) const { return position[core] >= 0; }
+    int top() const { return heap.front(); }
+    SimTime timeOf(int core) const { return readyTime[core]; }
+
+    void update(int core, SimTime time) {
+        SimTime old = readyTime[core];
+        readyTime[core] = time;
+        if (time < old) siftUp(position[core]);
+        else siftDown(position[core]);
+    }
+
+    void push(int core, SimTime time) {
+        readyTime[core] = time;
+        heap.push_back(core);
+        siftUp(heap.size() - 1);
+    }
+
+    void erase(int core) {
+        size_t i = position[core];
+        int last = heap.back();
+        heap.pop_back();
+        position[core] = -1;
+        if (last == core) return;
+        place(i, last);
+        siftUp(i);
+        siftDown(position[last]);
+    }
+
+    int pop() {
+        int core = top();
+        erase(core);
+        return core;
+    }
+};
+
+// Idle cores grouped by core class, each group ordered by when its cores went idle, so the simulator can ask
+// for the longest idle core overall or within one class.
+class IdleCoreSet {
+private:
+    std::vector<CoreHeap> groups;
+    std::vector<int> groupOf;
+    size_t count;
+
+public:
+    // Every core starts idle at time 0.
+    IdleCoreSet(const std::vector<int> &groupOfCore, int groupCount)
+        : groups(groupCount), groupOf(groupOfCore), count(groupOfCore.size()) {
+        int cores = static_cast<int>(groupOf.size());
+        for (CoreHeap &group : groups) group.reset(cores);
+        for (int core = 0; core < cores; ++core)
+            for (int group = 0; group < groupCount; ++group)
+                if (group != groupOf[core]) groups[group].erase(core);
+    }
+
+    bool empty() const { return count == 0; }
+    bool contains(int core) const { return groups[groupOf[core]].contains(core); }
+    bool groupEmpty(int group) const { return groups[group].empty(); }
+    int topOf(int group) const { return groups[group].top(); }
+
+    int top() const {
+        int best = -1;
+        for (const CoreHeap &group : groups) {
+            if (group.empty()) continue;
+            int core = group.top();
+            if (best < 0 || group.timeOf(core) < groups[groupOf[best]].timeOf(best) ||
+                (group.timeOf(core) == groups[groupOf[best]].timeOf(best) && core < best))
+                best = core;
+        }
+        return best;
+    }
+
+    void push(int core, SimTime now) {
+        groups[groupOf[core]].push(core, now);
+        count++;
+    }
+
+    void erase(int core) {
+        groups[groupOf[core]].erase(core);
+        count--;
+    }
+};
+
+enum class EventType { Arrival, Completion, QuantumExpiry, DeadlineCheck };
+
+struct Event {
+    SimTime time;
+    EventType type;
+    size_t process;
+    int core;
+    unsigned long long sequence;
+};
+
+class EventQueue {
+private:
+    struct Later {
+        bool operator()(const Event &a, const Event &b) const {
+            if (a.time != b.time) return a.time > b.time;
+            if (a.type != b.type) return a.type > b.type;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    std::priority_queue<Event, std::vector<Event>, Later> events;
+    unsigned long long nextSequence = 0;
+
+public:
+    bool empty() const { return events.empty(); }
+    const Event &top() const { return events.top(); }
+    void pop() { events.pop(); }
+
+    unsigned long long push(SimTime time, EventType type, size_t process, int core = -1) {
+        events.push(Event{time, type, process, core, nextSequence});
+        return nextSequence++;
+    }
+};
+
+// Binary indexed tree over [0, n): point add and prefix sums in O(log n).
+class FenwickTree {
+private:
+    std::vector<SimTime> tree;
+
+public:
+    void reset(size_t n) { tree.assign(n + 1, 0); }
+
+    void add(size_t index, SimTime delta) {
+        for (++index; index < tree.size(); index += index & (~index + 1)) tree[index] += delta;
+    }
+
+    // Sum of the first `count` entries.
+    SimTime prefix(size_t count) const {
+        SimTime sum = 0;
+        for (; count > 0; count -= count & (~count + 1)) sum += tree[count];
+        return sum;
+    }
+
+    // Smallest count whose prefix sum reaches target; entries must be non-negative.
+    size_t lowerBound(SimTime target) const {
+        size_t count = 0, step = 1;
+        while (step * 2 < tree.size()) step *= 2;
+        for (; step > 0; step /= 2) {
+            if (count + step < tree.size() && tree[count + step] < target) {
+                count += step;
+                target -= tree[count];
+            }
+        }
+        return count + 1;
+    }
+};
+
+// Minimum load per core in a segment tree, for first-fit and worst-fit placement in O(log cores).
+class CoreLoadTree {
+private:
+    std::vector<SimTime> tree;
+    size_t leaves = 1;
+
+public:
+    explicit CoreLoadTree(int cores = 0) { reset(cores); }
+
+    void reset(int cores) {
+        leaves = 1;
+        while (leaves < static_cast<size_t>(std::max(cores, 1))) leaves *= 2;
+        tree.assign(2 * leaves, std::numeric_limits<SimTime>::max());
+        for (int core = 0; core < cores; ++core) set(core, 0);
+    }
+
+    SimTime load(int core) const { return tree[leaves + core]; }
+    SimTime minimum() const { return tree[1]; }
+
+    void set(int core, SimTime value) {
+        size_t node = leaves + core;
+        tree[node] = value;
+        for (node /= 2; node > 0; node /= 2) tree[node] = std::min(tree[2 * node], tree[2 * node + 1]);
+    }
+
+    // Lowest-numbered core whose load is at most limit, or -1.
+    int firstAtMost(SimTime limit) const {
+        if (tree[1] > limit) return -1;
+        size_t node = 1;
+        while (node < leaves) node = tree[2 * node] <= limit ? 2 * node : 2 * node + 1;
+        return static_cast<int>(node - leaves);
+    }
+};
+
+// Min pairing heap over process indices, keyed by a value fixed at push time. Push is O(1) and pop amortized
+// O(log n); the nodes are arrays indexed by process, so neither allocates once the pairing scratch has grown.
+class PairingHeap {
+private:
+    static const size_t kNone = static_cast<size_t>(-1);
+    std::vector<SimTime> key;
+    std::vector<size_t> child;
+    std::vector<size_t> sibling;
+    std::vector<size_t> pairs;
+    size_t root = kNone;
+
+    bool before(size_t a, size_t b) const {
+        return key[a] != key[b] ? key[a] < key[b] : a < b;
+    }
+
+    size_t meld(size_t a, size_t b) {
+        if (a == kNone) return b;
+        if (b == kNone) return a;
+        if (before(b, a)) std::swap(a, b);
+        sibling[b] = child[a];
+        child[a] = b;
+        return a;
+    }
+
+public:
+    explicit PairingHeap(size_t nodes = 0) : key(nodes, 0), child(nodes, kNone), sibling(nodes, kNone) {}
+
+    bool empty() const { return root == kNone; }
+    size_t top() const { return root; }
+    SimTime topKey() const { return key[root]; }
+
+    void push(size_t node, SimTime nodeKey) {
+        key[node] = nodeKey;
+        child[node] = sibling[node] = kNone;
+        root = meld(root, node);
+    }
+
+    // Melds the root's children in pairs left to right, then folds the pairs together right to left.
+    size_t pop() {
+        size_t node = root;
+        pairs.clear();
+        for (size_t next = child[node]; next != kNone;) {
+            size_t after = sibling[next];
+            sibling[next] = kNone;
+            pairs.push_back(next);
+            next = after;
+        }
+        size_t melded = 0;
+        for (size_t i = 0; i < pairs.size(); i += 2)
+            pairs[melded++] = i + 1 < pairs.size() ? meld(pairs[i], pairs[i + 1]) : pairs[i];
+        root = kNone;
+        while (melded > 0) root = meld(pairs[--melded], root);
+        return node;
+    }
+};
+
+const size_t PairingHeap::kNone;
+
+// Where each core sits: its socket (NUMA node), last-level cache domain and physical core. Logical cores on the
+// same physical core are SMT siblings. Domain numbers are dense; cores are used in order, so a run on n cores
+// takes the first n.
+class CpuTopology {
+private:
+    std::vector<int> socketOf;
+    std::vector<int> cacheOf;
+    std::vector<int> physicalCoreOf;
+    std::vector<std::vector<int>> cacheCores;
+    std::vector<std::vector<int>> socketCaches;
+    std::map<int, int> socketIds;
+    std::map<std::pair<int, int>, int> cacheIds;
+    std::map<std::pair<int, int>, int> physicalCoreIds;
+
+    template <typename Key>
+    static int denseId(std::map<Key, int> &ids, const Key &key) {
+        return ids.insert(std::make_pair(key, static_cast<int>(ids.size()))).first->second;
+    }
+
+public:
+    enum Distance { Same, SmtSibling, SharedCache, SameSocket, RemoteSocket };
+
+    size_t size() const { return socketOf.size(); }
+    int socket(int core) const { return socketOf[core]; }
+
+    // Ids only need to be unique within their parent: an LLC id within its socket, a core id within its LLC.
+    void addCore(int socket, int cache, int physicalCore) {
+        int s = denseId(socketIds, socket);
+        int c = denseId(cacheIds, std::make_pair(s, cache));
+        int p = denseId(physicalCoreIds, std::make_pair(c, physicalCore));
+        if (static_cast<size_t>(s) == socketCaches.size()) socketCaches.push_back(std::vector<int>());
+        if (static_cast<size_t>(c) == cacheCores.size()) {
+            cacheCores.push_back(std::vector<int>());
+            socketCaches[s].push_back(c);
+        }
+        cacheCores[c].push_back(static_cast<int>(socketOf.size()));
+        socketOf.push_back(s);
+        cacheOf.push_back(c);
+        physicalCoreOf.push_back(p);
+    }
+
+    Distance distance(int a, int b) const {
+        if (a == b) return Same;
+        if (physicalCoreOf[a] == physicalCoreOf[b]) return SmtSibling;
+        if (cacheOf[a] == cacheOf[b]) return SharedCache;
+        return socketOf[a] == socketOf[b] ? SameSocket : RemoteSocket;
+    }
+
+    // The nearest of the first `cores` cores to `from` that accept() takes: from itself, its SMT siblings, the
+    // rest of its LLC domain, then the rest of its socket. Returns -1 when nothing on the socket qualifies.
+    template <typename Accept>
+    int nearest(int from, int cores, Accept accept) const {
+        if (accept(from)) return from;
+        const std::vector<int> &local = cacheCores[cacheOf[from]];
+        for (int pass = 0; pass < 2; ++pass)
+            for (int core : local)
+                if (core < cores && core != from && (physicalCoreOf[core] == physicalCoreOf[from]) == (pass == 0) &&
+                    accept(core))
+                    return core;
+        for (int cache : socketCaches[socketOf[from]]) {
+            if (cache == cacheOf[from]) continue;
+            for (int core : cacheCores[cache])
+                if (core < cores && accept(core)) return core;
+        }
+        return -1;
+    }
+};
+
+struct FastForward {
+    std::vector<size_t> processes;
+    SimTime slice = 0;
+    SimTime rounds = 0;
+};
+
+class SchedulingPolicy {
+public:
+    virtual ~SchedulingPolicy() {}
+
+    // Queue a ready process; returns the core whose queue received it, or -1 for a shared queue.
+    virtual int enqueue(size_t process, int lastCore, SimTime now) = 0;
+    virtual bool pick(int core, SimTime now, size_t &process) = 0;
+    // Length of the slice about to start on core, whose picked process needs remainingTime more on that core.
+    virtual SimTime sliceFor(int, SimTime remainingTime) const { return remainingTime; }
+    // Time core spends before the process it just picked starts running, such as fetching stolen work.
+    virtual SimTime dispatchDelay(int) const { return 0; }
+    // The picked process starts running on core at begin, once switch costs and other delays have passed, for a
+    // slice of length wall-clock time.
+    virtual void started(int, SimTime, SimTime) {}
+    // The process the next pick from the shared queue would return, for policies that can tell.
+    virtual bool peek(size_t &) const { return false; }
+    virtual bool tracksDeadlines() const { return false; }
+    // Asked after an arrival lands in core's queue, and with -1 once every core is busy and the shared queue
+    // still holds work: names the busy core whose slice should stop, or returns -1.
+    virtual int preemptionTarget(int, SimTime) { return -1; }
+    // The core's slice ended, by completion, expiry or preemption.
+    virtual void release(int, SimTime) {}
+    // Reports whole rounds an idle core will deterministically repeat before anything can change them.
+    virtual bool fastForward(int, SimTime, FastForward &) { return false; }
+};
+
+class RankedPolicy : public SchedulingPolicy {
+private:
+    std::vector<size_t> order;
+    std::vector<size_t> rankOf;
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+    bool deadlines;
+
+public:
+    RankedPolicy(const std::vector<size_t> &dispatchOrder, bool countDeadlineMisses)
+        : order(dispatchOrder), rankOf(dispatchOrder.size()), deadlines(countDeadlineMisses) {
+        for (size_t rank = 0; rank < order.size(); ++rank) rankOf[order[rank]] = rank;
+    }
+
+    int enqueue(size_t process, int, SimTime) override {
+        ready.push(rankOf[process]);
+        return -1;
+    }
+
+    bool pick(int, SimTime, size_t &process) override {
+        if (ready.empty()) return false;
+        process = order[ready.top()];
+        ready.pop();
+        return true;
+    }
+
+    bool peek(size_t &process) const override {
+        if (ready.empty()) return false;
+        process = order[ready.top()];
+        return true;
+    }
+
+    bool tracksDeadlines() const override { return deadlines; }
+};
+
+// Arrivals are dealt to the cores in turn. With stealing enabled, a core that runs dry takes the newer half of
+// the queue with the most surplus, the jobs its own core will not run next, and an arrival that would have to
+// wait goes with the newer half of its queue to an idle core. A lone job queued on an idle core is never stolen,
+// since that core is about to pick it. Either way the thief spends stealCost before it runs the stolen work.
+// Given a topology, both prefer a partner on the same socket, nearest first, and only look further when the
+// socket has none.
+class RoundRobinPolicy : public SchedulingPolicy {
+private:
+    const ProcessTable &processes;
+    const std::vector<int32_t> &remainingTime;
+    const std::vector<size_t> &arrivalOrder;
+    std::vector<std::deque<size_t>> coreQueues;
+    std::vector<size_t> fastForwardCooldown;
+    SimTime timeQuantum;
+    size_t arrivals = 0;
+
+    bool stealing = false;
+    SimTime stealCost = 0;
+    SystemMetrics *stealMetrics = nullptr;
+    const CpuTopology *topology = nullptr;
+    // Cores by descending surplus, and idle cores with nothing queued first.
+    CoreHeap largestSurplus;
+    CoreHeap idleCores;
+    std::vector<char> busy;
+    std::vector<SimTime> owedDelay;
+    std::vector<SimTime> startDelay;
+
+    // Queued jobs beyond the one an idle core is about to pick itself; only those are worth stealing.
+    SimTime surplus(int core) const {
+        return static_cast<SimTime>(coreQueues[core].size()) - (busy[core] ? 0 : 1);
+    }
+
+    void refreshCore(int core) {
+        largestSurplus.update(core, -surplus(core));
+        idleCores.update(core, busy[core] || !coreQueues[core].empty() ? 1 : 0);
+    }
+
+    void steal(int thief, int victim) {
+        std::deque<size_t> &from = coreQueues[victim], &to = coreQueues[thief];
+        size_t count = (from.size() + 1) / 2;
+        to.insert(to.end(), from.end() - count, from.end());
+        from.erase(from.end() - count, from.end());
+        owedDelay[thief] += stealCost;
+        stealMetrics->steals++;
+        stealMetrics->stolenProcesses += count;
+        stealMetrics->stealOverhead += stealCost;
+        refreshCore(victim);
+        refreshCore(thief);
+    }
+
+    SimTime nextArrivalFor(int core) const {
+        size_t cores = coreQueues.size();
+        size_t next = arrivals + (core + cores - arrivals % cores) % cores;
+        if (next >= arrivalOrder.size()) return std::numeric_limits<SimTime>::max();
+        return processes.arrivalTime[arrivalOrder[next]];
+    }
+
+public:
+    RoundRobinPolicy(const ProcessTable &procs, const std::vector<int32_t> &remaining,
+                     const std::vector<size_t> &order, int numCores, int quantum)
+        : processes(procs), remainingTime(remaining), arrivalOrder(order), coreQueues(numCores),
+          fastForwardCooldown(numCores, 0), timeQuantum(std::max(1, quantum)) {}
+
+    // Steals and their cost are counted in metrics.
+    void enableStealing(SimTime cost, SystemMetrics &metrics, const CpuTopology *cpus = nullptr) {
+        int cores = static_cast<int>(coreQueues.size());
+        stealing = true;
+        stealCost = std::max<SimTime>(0, cost);
+        stealMetrics = &metrics;
+        topology = cpus;
+        largestSurplus.reset(cores);
+        idleCores.reset(cores);
+        busy.assign(cores, 0);
+        owedDelay.assign(cores, 0);
+        startDelay.assign(cores, 0);
+    }
+
+    int enqueue(size_t process, int lastCore, SimTime) override {
+        int core = lastCore >= 0 ? lastCore : static_cast<int>(arrivals++ % coreQueues.size());
+        coreQueues[core].push_back(process);
+        if (!stealing) return core;
+        refreshCore(core);
+        if (lastCore < 0 && (busy[core] || coreQueues[core].size() > 1)) {
+            int thief = -1;
+            if (topology)
+                thief = topology->nearest(core, static_cast<int>(coreQueues.size()),
+                                          [this](int candidate) { return idleCores.timeOf(candidate) == 0; });
+            if (thief < 0) thief = idleCores.top();
+            if (idleCores.timeOf(thief) == 0) {
+                steal(thief, core);
+                return thief;
+            }
+        }
+        return core;
+    }
+
+    bool pick(int core, SimTime, size_t &process) override {
+        if (coreQueues[core].empty()) {
+            if (!stealing) return false;
+            int victim = -1;
+            if (topology)
+                victim = topology->nearest(core, static_cast<int>(coreQueues.size()),
+                                           [this](int candidate) { return surplus(candidate) > 0; });
+            if (victim < 0) victim = largestSurplus.top();
+            if (surplus(victim) <= 0) return false;
+            steal(core, victim);
+        }
+        process = coreQueues[core].front();
+        coreQueues[core].pop_front();
+        if (stealing) {
+            busy[core] = 1;
+            startDelay[core] = owedDelay[core];
+            owedDelay[core] = 0;
+            refreshCore(core);
+        }
+        return true;
+    }
+
+    SimTime sliceFor(int, SimTime remaining) const override {
+        return std::min<SimTime>(timeQuantum, remaining);
+    }
+
+    SimTime dispatchDelay(int core) const override { return stealing ? startDelay[core] : 0; }
+
+    void release(int core, SimTime) override {
+        if (!stealing) return;
+        busy[core] = 0;
+        refreshCore(core);
+    }
+
+    // Rounds are only predictable while no other core can take from the queue.
+    bool fastForward(int core, SimTime now, FastForward &batch) override {
+        const std::deque<size_t> &queue = coreQueues[core];
+        if (queue.empty() || stealing) return false;
+        // A failed scan is not retried until the queue has rotated once, keeping dispatch amortized O(1).
+        if (fastForwardCooldown[core] > 0) {
+            fastForwardCooldown[core]--;
+            return false;
+        }
+        SimTime period = timeQuantum * static_cast<SimTime>(queue.size());
+        SimTime rounds = std::numeric_limits<SimTime>::max();
+        SimTime arrival = nextArrivalFor(core);
+        if (arrival != std::numeric_limits<SimTime>::max())
+            rounds = (arrival - now - 1) / period;
+        if (rounds < 2) return false;
+        for (size_t index : queue)
+            rounds = std::min<SimTime>(rounds, (remainingTime[index] - 1) / timeQuantum);
+        if (rounds < 2) {
+            fastForwardCooldown[core] = queue.size();
+            return false;
+        }
+        batch.processes.assign(queue.begin(), queue.end());
+        batch.slice = timeQuantum;
+        batch.rounds = rounds;
+        return true;
+    }
+};
+
+struct FeedbackQueueConfig {
+    static const int kMaxLevels = 32;
+    int levels = 3;
+    // Quantum of each level; when empty, level l gets the run's quantum times 2^l.
+    std::vector<int> quanta;
+    // Every boostInterval time units all jobs return to the top level; 0 never boosts.
+    SimTime boostInterval = 0;
+};
+
+const int FeedbackQueueConfig::kMaxLevels;
+
+inline int lowestSetBit(uint32_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(bits);
+#endif
+}
+
+// Per-core FIFO queues like Round Robin's, split into levels that run top level first. A job that uses up its
+// level's quantum, over one slice or several, drops a level; a job preempted before then resumes at the head of
+// its level with the rest of its quantum. A bitmap of each core's non-empty levels makes picking the next job a
+// find-first-set. Unlike Round Robin's deques, each queue is a list threaded through the processes, so a boost
+// splices whole levels onto the top one in O(1) per level, and a queued job learns it was boosted when it is
+// picked. Boosts are applied when the policy is next consulted, which is the earliest anything can observe them.
+class FeedbackQueuePolicy : public SchedulingPolicy {
+private:
+    static const size_t kNone = static_cast<size_t>(-1);
+
+    struct Queue {
+        size_t head = kNone;
+        size_t tail = kNone;
+    };
+
+    std::vector<Queue> queues;
+    std::vector<size_t> next;
+    std::vector<uint32_t> nonEmpty;
+    std::vector<SimTime> quantum;
+    std::vector<int> level;
+    std::vector<SimTime> used;
+    // Boosts so far, and the count each queued job last saw.
+    unsigned long long boosts = 0;
+    std::vector<unsigned long long> boostsSeen;
+    std::vector<int> runningLevel;
+    std::vector<size_t> runningProcess;
+    std::vector<SimTime> sliceStart;
+    int levels;
+    SimTime boostInterval;
+    SimTime nextBoost;
+    size_t arrivals = 0;
+
+    Queue &queue(int core, int at) { return queues[static_cast<size_t>(core) * levels + at]; }
+
+    void boost(SimTime now) {
+        if (boostInterval <= 0 || now < nextBoost) return;
+        SimTime boostTime = nextBoost + (now - nextBoost) / boostInterval * boostInterval;
+        nextBoost = boostTime + boostInterval;
+        boosts++;
+        for (int core = 0; core < static_cast<int>(nonEmpty.size()); ++core) {
+            Queue &top = queue(core, 0);
+            for (int at = 1; at < levels; ++at) {
+                Queue &lower = queue(core, at);
+                if (lower.head == kNone) continue;
+                if (top.head == kNone) top.head = lower.head;
+                else next[top.tail] = lower.head;
+                top.tail = lower.tail;
+                lower = Queue();
+            }
+            nonEmpty[core] = top.head == kNone ? 0 : 1;
+            if (runningLevel[core] < levels) {
+                runningLevel[core] = 0;
+                level[runningProcess[core]] = 0;
+                used[runningProcess[core]] = 0;
+                sliceStart[core] = std::max(sliceStart[core], boostTime);
+            }
+        }
+    }
+
+public:
+    FeedbackQueuePolicy(size_t processCount, int numCores, int baseQuantum, const FeedbackQueueConfig &config)
+        : next(processCount, kNone), nonEmpty(numCores, 0), level(processCount, 0), used(processCount, 0),
+          boostsSeen(processCount, 0), runningProcess(numCores, 0), sliceStart(numCores, 0),
+          boostInterval(config.boostInterval), nextBoost(config.boostInterval) {
+        if (config.quanta.empty())
+            for (int at = 0; at < std::min(std::max(1, config.levels), FeedbackQueueConfig::kMaxLevels); ++at)
+                quantum.push_back(static_cast<SimTime>(std::max(1, baseQuantum)) << at);
+        else
+            quantum.assign(config.quanta.begin(), config.quanta.end());
+        levels = static_cast<int>(quantum.size());
+        queues.resize(static_cast<size_t>(numCores) * levels);
+        runningLevel.assign(numCores, levels);
+    }
+
+    int enqueue(size_t process, int lastCore, SimTime now) override {
+        boost(now);
+        int core = lastCore >= 0 ? lastCore : static_cast<int>(arrivals++ % nonEmpty.size());
+        if (used[process] >= quantum[level[process]]) {
+            used[process] = 0;
+            if (level[process] + 1 < levels) level[process]++;
+        }
+        Queue &ready = queue(core, level[process]);
+        if (ready.head == kNone) {
+            next[process] = kNone;
+            ready.head = ready.tail = process;
+        } else if (used[process] > 0) {
+            next[process] = ready.head;
+            ready.head = process;
+        } else {
+            next[process] = kNone;
+            next[ready.tail] = process;
+            ready.tail = process;
+        }
+        boostsSeen[process] = boosts;
+        nonEmpty[core] |= 1u << level[process];
+        return core;
+    }
+
+    bool pick(int core, SimTime now, size_t &process) override {
+        boost(now);
+        if (nonEmpty[core] == 0) return false;
+        int at = lowestSetBit(nonEmpty[core]);
+        Queue &ready = queue(core, at);
+        process = ready.head;
+        ready.head = next[process];
+        if (ready.head == kNone) {
+            ready.tail = kNone;
+            nonEmpty[core] &= ~(1u << at);
+        }
+        if (boostsSeen[process] != boosts) used[process] = 0;
+        level[process] = at;
+        runningLevel[core] = at;
+        runningProcess[core] = process;
+        return true;
+    }
+
+    void started(int core, SimTime begin, SimTime) override { sliceStart[core] = begin; }
+
+    SimTime sliceFor(int core, SimTime remaining) const override {
+        size_t process = runningProcess[core];
+        return std::min<SimTime>(quantum[runningLevel[core]] - used[process], remaining);
+    }
+
+    void release(int core, SimTime now) override {
+        boost(now);
+        used[runningProcess[core]] += std::max<SimTime>(0, now - sliceStart[core]);
+        runningLevel[core] = levels;
+    }
+
+    int preemptionTarget(int core, SimTime now) override {
+        if (core < 0) return -1;
+        boost(now);
+        if (runningLevel[core] == levels || nonEmpty[core] == 0) return -1;
+        return lowestSetBit(nonEmpty[core]) < runningLevel[core] ? core : -1;
+    }
+};
+
+const size_t FeedbackQueuePolicy::kNone;
+
+// Per-core ready heaps ordered by aged priority. Every agingInterval time units of waiting lower the
+// effective priority value by one, so a heap key of base * agingInterval + readySince never needs updating.
+// An arrival goes to an idle core if there is one, then to the core running the least urgent process if it
+// can preempt that, and otherwise to the core with the least queued work.
+class PreemptivePriorityPolicy : public SchedulingPolicy {
+private:
+    struct Entry {
+        SimTime key;
+        SimTime readySince;
+        size_t process;
+    };
+
+    struct Later {
+        bool operator()(const Entry &a, const Entry &b) const {
+            if (a.key != b.key) return a.key > b.key;
+            if (a.readySince != b.readySince) return a.readySince > b.readySince;
+            return a.process > b.process;
+        }
+    };
+
+    const std::vector<int32_t> &remainingTime;
+    std::vector<std::priority_queue<Entry, std::vector<Entry>, Later>> ready;
+    // Priority scaled by agingInterval, less the aging earned in earlier waits.
+    std::vector<SimTime> agedPriority;
+    std::vector<SimTime> runningPriority;
+    std::vector<char> busy;
+    CoreHeap victims;
+    CoreHeap queuedWork;
+    SimTime agingInterval;
+
+    SimTime priorityAt(const Entry &entry, SimTime now) const {
+        return agingInterval > 0 ? entry.key - now : entry.key;
+    }
+
+    // Idle cores sort first, then cores whose running (or about to run) process is least urgent.
+    void refreshVictim(int core, SimTime now) {
+        SimTime urgency = std::numeric_limits<SimTime>::min();
+        if (busy[core]) urgency = -runningPriority[core];
+        else if (!ready[core].empty()) urgency = -priorityAt(ready[core].top(), now);
+        victims.update(core, urgency);
+    }
+
+public:
+    PreemptivePriorityPolicy(const ProcessTable &processes, const std::vector<int32_t> &remaining, int numCores,
+                             int interval)
+        : remainingTime(remaining), ready(numCores), agedPriority(processes.size()), runningPriority(numCores, 0),
+          busy(numCores, 0), victims(numCores), queuedWork(numCores), agingInterval(std::max(0, interval)) {
+        SimTime scale = std::max<SimTime>(1, agingInterval);
+        for (size_t i = 0; i < processes.size(); ++i) agedPriority[i] = processes.priority[i] * scale;
+        for (int core = 0; core < numCores; ++core) victims.update(core, std::numeric_limits<SimTime>::min());
+    }
+
+    int enqueue(size_t process, int lastCore, SimTime now) override {
+        int core = lastCore;
+        if (core < 0) {
+            core = victims.top();
+            SimTime urgency = victims.timeOf(core);
+            // A busy victim is only worth joining if the newcomer will preempt it.
+            if (urgency != std::numeric_limits<SimTime>::min() && agedPriority[process] >= -urgency)
+                core = queuedWork.top();
+        }
+        SimTime key = agingInterval > 0 ? agedPriority[process] + now : agedPriority[process];
+        ready[core].push(Entry{key, now, process});
+        queuedWork.update(core, queuedWork.timeOf(core) + remainingTime[process]);
+        refreshVictim(core, now);
+        return core;
+    }
+
+    bool pick(int core, SimTime now, size_t &process) override {
+        if (ready[core].empty()) return false;
+        const Entry &entry = ready[core].top();
+        process = entry.process;
+        queuedWork.update(core, queuedWork.timeOf(core) - remainingTime[process]);
+        runningPriority[core] = priorityAt(entry, now);
+        if (agingInterval > 0) agedPriority[process] = runningPriority[core];
+        ready[core].pop();
+        busy[core] = 1;
+        refreshVictim(core, now);
+        return true;
+    }
+
+    int preemptionTarget(int core, SimTime now) override {
+        if (core < 0 || !busy[core] || ready[core].empty()) return -1;
+        return priorityAt(ready[core].top(), now) < runningPriority[core] ? core : -1;
+    }
+
+    void release(int core, SimTime now) override {
+        busy[core] = 0;
+        refreshVictim(core, now);
+    }
+};
+
+// Ready jobs ordered by absolute deadline; jobs without one run after every deadline, in arrival order.
+struct DeadlineOrder {
+    struct Entry {
+        SimTime deadline;
+        size_t process;
+    };
+
+    struct Later {
+        bool operator()(const Entry &a, const Entry &b) const {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.process > b.process;
+        }
+    };
+
+    typedef std::priority_queue<Entry, std::vector<Entry>, Later> Queue;
+
+    static SimTime absoluteDeadline(const ProcessTable &processes, size_t index) {
+        if (processes.deadline[index] <= 0) return std::numeric_limits<SimTime>::max();
+        return static_cast<SimTime>(processes.arrivalTime[index]) + processes.deadline[index];
+    }
+};
+
+// One shared deadline queue. Once every core is busy, a job with an earlier deadline than the latest
+// running one preempts it, so the cores always run the earliest deadlines available.
+class GlobalEdfPolicy : public SchedulingPolicy {
+private:
+    const ProcessTable &processes;
+    DeadlineOrder::Queue ready;
+    CoreHeap latestDeadline;
+    std::vector<SimTime> runningDeadline;
+    int busyCores = 0;
+
+public:
+    GlobalEdfPolicy(const ProcessTable &procs, int numCores)
+        : processes(procs), latestDeadline(numCores), runningDeadline(numCores, 0) {}
+
+    int enqueue(size_t process, int, SimTime) override {
+        ready.push(DeadlineOrder::Entry{DeadlineOrder::absoluteDeadline(processes, process), process});
+        return -1;
+    }
+
+    bool pick(int core, SimTime, size_t &process) override {
+        if (ready.empty()) return false;
+        process = ready.top().process;
+        runningDeadline[core] = ready.top().deadline;
+        ready.pop();
+        // The heap is a min-heap, so the latest deadline is kept as the most negative key.
+        latestDeadline.update(core, runningDeadline[core] == std::numeric_limits<SimTime>::max()
+                                        ? std::numeric_limits<SimTime>::min()
+                                        : -runningDeadline[core]);
+        busyCores++;
+        return true;
+    }
+
+    void release(int core, SimTime) override {
+        latestDeadline.update(core, std::numeric_limits<SimTime>::max());
+        busyCores--;
+    }
+
+    bool peek(size_t &process) const override {
+        if (ready.empty()) return false;
+        process = ready.top().process;
+        return true;
+    }
+
+    int preemptionTarget(int core, SimTime) override {
+        if (core >= 0 || ready.empty() || busyCores < static_cast<int>(runningDeadline.size())) return -1;
+        int victim = latestDeadline.top();
+        return ready.top().deadline < runningDeadline[victim] ? victim : -1;
+    }
+
+    bool tracksDeadlines() const override { return true; }
+};
+
+// Jobs are bound to a core on arrival by bin-packing their density (burst / relative deadline, in millionths)
+// onto the cores' active load, first-fit or worst-fit; a job that fits nowhere goes to the least loaded core.
+// Jobs without a deadline take no part in packing and go to the core with the least queued work.
+// Each core then runs preemptive EDF on its own queue.
+class PartitionedEdfPolicy : public SchedulingPolicy {
+private:
+    static const SimTime kCapacity = 1000000;
+
+    const ProcessTable &processes;
+    const std::vector<int32_t> &remainingTime;
+    std::vector<DeadlineOrder::Queue> ready;
+    std::vector<SimTime> runningDeadline;
+    std::vector<char> busy;
+    std::vector<size_t> runningProcess;
+    std::vector<int> boundCore;
+    CoreLoadTree density;
+    CoreHeap queuedWork;
+    bool worstFit;
+
+    SimTime densityOf(size_t index) const {
+        if (processes.deadline[index] <= 0) return 0;
+        return (static_cast<SimTime>(processes.burstTime[index]) * kCapacity + processes.deadline[index] - 1) /
+               processes.deadline[index];
+    }
+
+public:
+    PartitionedEdfPolicy(const ProcessTable &procs, const std::vector<int32_t> &remaining, int numCores,
+                         bool useWorstFit)
+        : processes(procs), remainingTime(remaining), ready(numCores), runningDeadline(numCores, 0),
+          busy(numCores, 0), runningProcess(numCores, 0), boundCore(procs.size(), -1), density(numCores),
+          queuedWork(numCores),
+          worstFit(useWorstFit) {}
+
+    int enqueue(size_t process, int lastCore, SimTime) override {
+        int core = lastCore;
+        if (core < 0) {
+            SimTime load = densityOf(process);
+            if (load == 0) core = queuedWork.top();
+            else if (!worstFit) core = density.firstAtMost(kCapacity - load);
+            if (core < 0) core = density.firstAtMost(density.minimum());
+            density.set(core, density.load(core) + load);
+            boundCore[process] = core;
+        }
+        ready[core].push(DeadlineOrder::Entry{DeadlineOrder::absoluteDeadline(processes, process), process});
+        queuedWork.update(core, queuedWork.timeOf(core) + remainingTime[process]);
+        return core;
+    }
+
+    bool pick(int core, SimTime, size_t &process) override {
+        if (ready[core].empty()) return false;
+        process = ready[core].top().process;
+        runningDeadline[core] = ready[core].top().deadline;
+        ready[core].pop();
+        queuedWork.update(core, queuedWork.timeOf(core) - remainingTime[process]);
+        busy[core] = 1;
+        runningProcess[core] = process;
+        return true;
+    }
+
+    // A finished job's density leaves its core.
+    void release(int core, SimTime) override {
+        busy[core] = 0;
+        size_t process = runningProcess[core];
+        if (remainingTime[process] == 0) density.set(core, density.load(core) - densityOf(process));
+    }
+
+    int preemptionTarget(int core, SimTime) override {
+        if (core < 0 || !busy[core] || ready[core].empty()) return -1;
+        return ready[core].top().deadline < runningDeadline[core] ? core : -1;
+    }
+
+    bool tracksDeadlines() const override { return true; }
+};
+
+// One shared queue ordered by remaining work. Once every core is busy, a ready job with less work left than the
+// running job that will finish last preempts it, so the cores always run the shortest remaining work. Finish
+// times come from the slice's real start and length, which core speed and dispatch delays both stretch.
+class ShortestRemainingPolicy : public SchedulingPolicy {
+private:
+    const std::vector<int32_t> &remainingTime;
+    PairingHeap ready;
+    CoreHeap latestFinish;
+    std::vector<size_t> runningProcess;
+    std::vector<SimTime> finishTime;
+    std::vector<SimTime> sliceLength;
+    std::vector<SimTime> startWork;
+    int busyCores = 0;
+
+    // Work the core's job has left at now, done at a steady rate over its slice and rounded up.
+    SimTime workLeft(int core, SimTime now) const {
+        if (sliceLength[core] <= 0) return 0;
+        SimTime left = std::max<SimTime>(0, std::min(sliceLength[core], finishTime[core] - now));
+        return (startWork[core] * left + sliceLength[core] - 1) / sliceLength[core];
+    }
+
+public:
+    ShortestRemainingPolicy(const std::vector<int32_t> &remaining, int numCores)
+        : remainingTime(remaining), ready(remaining.size()), latestFinish(numCores), runningProcess(numCores, 0),
+          finishTime(numCores, 0), sliceLength(numCores, 0), startWork(numCores, 0) {}
+
+    int enqueue(size_t process, int, SimTime) override {
+        ready.push(process, remainingTime[process]);
+        return -1;
+    }
+
+    bool pick(int core, SimTime, size_t &process) override {
+        if (ready.empty()) return false;
+        process = ready.pop();
+        runningProcess[core] = process;
+        busyCores++;
+        return true;
+    }
+
+    void started(int core, SimTime begin, SimTime length) override {
+        finishTime[core] = begin + length;
+        sliceLength[core] = length;
+        startWork[core] = remainingTime[runningProcess[core]];
+        latestFinish.update(core, -finishTime[core]);
+    }
+
+    void release(int core, SimTime) override {
+        latestFinish.update(core, std::numeric_limits<SimTime>::max());
+        busyCores--;
+    }
+
+    bool peek(size_t &process) const override {
+        if (ready.empty()) return false;
+        process = ready.top();
+        return true;
+    }
+
+    int preemptionTarget(int core, SimTime now) override {
+        if (core >= 0 || ready.empty() || busyCores < static_cast<int>(finishTime.size())) return -1;
+        int victim = latestFinish.top();
+        return ready.topKey() < workLeft(victim, now) ? victim : -1;
+    }
+};
+
+struct WorkStealingConfig {
+    // Time a core spends taking work from another core's queue before it can run it.
+    SimTime stealCost = 1;
+};
+
+struct FairSchedulerConfig {
+    // No slice is shorter than this, and an arrival preempts only a job at least this far ahead of it.
+    SimTime minGranularity = 1;
+};
+
+// Per-core runqueues ordered by virtual runtime, as in Linux's CFS. Linux keeps them in a red-black tree, but only
+// the leftmost job is ever taken, so a binary heap per core does the same work with less pointer chasing.
+// Priorities 0-255 map onto the 40 nice levels and their load weights, and a job's vruntime advances by its run
+// time scaled by 1024 / weight.
+// Each pick takes the leftmost job and runs it for its weight's share of the target latency, stretched so no
+// slice is shorter than the minimum granularity. Arrivals join the core with the least queued weight at that
+// core's minimum vruntime, and preempt its running job if they are more than a granularity behind it.
+class FairSchedulerPolicy : public SchedulingPolicy {
+private:
+    static const SimTime kNiceZeroWeight = 1024;
+    // vruntime is kept in 1/1024ths of a time unit so small weights do not round slices away.
+    static const SimTime kVruntimeScale = 1024;
+
+    typedef std::pair<SimTime, size_t> Entry;
+    typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> RunQueue;
+
+    const std::vector<int32_t> &remainingTime;
+    std::vector<RunQueue> ready;
+    std::vector<SimTime> weight;
+    std::vector<SimTime> vruntime;
+    std::vector<SimTime> minVruntime;
+    // Weight of each core's queued and running jobs, which also orders cores for placement.
+    CoreHeap load;
+    std::vector<char> busy;
+    std::vector<size_t> runningProcess;
+    std::vector<SimTime> sliceStart;
+    std::vector<SimTime> slice;
+    SimTime targetLatency;
+    SimTime minGranularity;
+
+    static SimTime weightOf(int32_t priority) {
+        static const SimTime kWeights[40] = {
+            88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+            9548,  7620,  6100,  4904,  3906,  3121,  2501,  1991,  1586,  1277,
+            1024,  820,   655,   526,   423,   335,   272,   215,   172,   137,
+            110,   87,    70,    56,    45,    36,    29,    23,    18,    15};
+        return kWeights[std::min(255, std::max(0, static_cast<int>(priority))) * 40 / 256];
+    }
+
+    SimTime scaled(SimTime delta, size_t process) const {
+        return delta * kNiceZeroWeight * kVruntimeScale / weight[process];
+    }
+
+    // The running job's vruntime as of now.
+    SimTime currentVruntime(int core, SimTime now) const {
+        size_t process = runningProcess[core];
+        return vruntime[process] + scaled(std::max<SimTime>(0, now - sliceStart[core]), process);
+    }
+
+public:
+    FairSchedulerPolicy(const ProcessTable &processes, const std::vector<int32_t> &remaining, int numCores,
+                        int latency, const FairSchedulerConfig &config)
+        : remainingTime(remaining), ready(numCores), weight(processes.size()), vruntime(processes.size(), 0),
+          minVruntime(numCores, 0), load(numCores), busy(numCores, 0), runningProcess(numCores, 0),
+          sliceStart(numCores, 0), slice(numCores, 0), targetLatency(std::max(1, latency)),
+          minGranularity(std::max<SimTime>(1, config.minGranularity)) {
+        for (size_t i = 0; i < processes.size(); ++i) weight[i] = weightOf(processes.priority[i]);
+    }
+
+    int enqueue(size_t process, int lastCore, SimTime) override {
+        int core = lastCore;
+        if (core < 0) {
+            core = load.top();
+            load.update(core, load.timeOf(core) + weight[process]);
+            vruntime[process] = std::max(vruntime[process], minVruntime[core]);
+        }
+        ready[core].push(Entry(vruntime[process], process));
+        return core;
+    }
+
+    bool pick(int core, SimTime, size_t &process) override {
+        RunQueue &queue = ready[core];
+        if (queue.empty()) return false;
+        process = queue.top().second;
+        queue.pop();
+        minVruntime[core] = std::max(minVruntime[core], vruntime[process]);
+        SimTime period = std::max(targetLatency, static_cast<SimTime>(queue.size() + 1) * minGranularity);
+        slice[core] = std::max(minGranularity, period * weight[process] / load.timeOf(core));
+        busy[core] = 1;
+        runningProcess[core] = process;
+        return true;
+    }
+
+    void started(int core, SimTime begin, SimTime) override { sliceStart[core] = begin; }
+
+    SimTime sliceFor(int core, SimTime remaining) const override {
+        return std::min<SimTime>(slice[core], remaining);
+    }
+
+    // Charges the slice to the job's vruntime; a finished job's weight leaves its core.
+    void release(int core, SimTime now) override {
+        size_t process = runningProcess[core];
+        vruntime[process] = currentVruntime(core, now);
+        busy[core] = 0;
+        if (remainingTime[process] == 0) load.update(core, load.timeOf(core) - weight[process]);
+        SimTime leftmost = ready[core].empty() ? vruntime[process] : ready[core].top().first;
+        minVruntime[core] = std::max(minVruntime[core], std::min(vruntime[process], leftmost));
+    }
+
+    int preemptionTarget(int core, SimTime now) override {
+        if (core < 0 || !busy[core] || ready[core].empty()) return -1;
+        const Entry &leftmost = ready[core].top();
+        return currentVruntime(core, now) - leftmost.first > scaled(minGranularity, leftmost.second) ? core : -1;
+    }
+};
+
+class EventSimulator {
+private:
+    const ProcessTable &processes;
+    ScheduleResult &result;
+    std::vector<GanttTrack> &ganttCharts;
+    SystemMetrics &metrics;
+    int numCores;
+
+    EventQueue events;
+    const CorePlatform &platform;
+    IdleCoreSet idleCores;
+    const std::vector<size_t> &arrivalOrder;
+    size_t nextArrival = 0;
+    std::vector<SimTime> sliceStart;
+    std::vector<char> finished;
+    std::vector<int> pendingCores;
+    std::vector<char> pendingFlag;
+    FastForward batch;
+    std::vector<int> batchIds;
+    // The process each core ran last, so a resumed slice of the same process is not a context switch.
+    std::vector<size_t> lastRun;
+    SwitchCostModel costs;
+    std::vector<SimTime> stoppedAt;
+    const CpuTopology *topology = nullptr;
+    std::vector<int> homeSocket;
+    // Core speeds other than 100%, or frequency levels below it, turn slices into work at speed * level / 10000
+    // per time unit. partialWork carries the 1/10000ths of a unit a process has done beyond remainingTime, and
+    // runTime the time it spent running, so its waiting time excludes a slow core's extra run time.
+    bool scaledSpeeds = false;
+    std::vector<int> partialWork;
+    std::vector<SimTime> runTime;
+    std::vector<SimTime> busySince;
+    DvfsConfig dvfs;
+    bool scaleFrequency = false;
+    std::vector<int> level;
+    double frequencyTime = 0;
+    IdleStateConfig idle;
+    std::vector<SimTime> idleSince;
+    FairnessConfig fairness;
+    // Consolidation sends shared-queue picks to the most recently idled core, keyed by minus its idle time.
+    bool consolidate = false;
+    CoreHeap recentlyIdle;
+    bool energyPlacement = false;
+    bool deadlinePlacement = false;
+    bool sharedWork = false;
+    SimTime makespan = 0;
+
+    static const size_t kIdle = static_cast<size_t>(-1);
+    std::vector<size_t> running;
+    std::vector<SimTime> sliceEnd;
+    // Sequence number of each core's live slice-end event, or kNoSlice; anything else for that core is stale.
+    // Sequences count up from 0, so none reaches kNoSlice.
+    static const unsigned long long kNoSlice = std::numeric_limits<unsigned long long>::max();
+    std::vector<unsigned long long> sliceEvent;
+
+    // Priority inversion: ranks number the distinct priority values, most urgent first. The clock for rank r
+    // advances whenever a process of lower priority than r is running, so a wait's inverted time is the
+    // clock difference between becoming ready and being picked.
+    bool inversions = false;
+    std::vector<int32_t> priorityRank;
+    FenwickTree runningRanks;
+    FenwickTree inversionClock;
+    std::vector<SimTime> readyClock;
+    std::vector<char> inverted;
+    SimTime runningCount = 0;
+    SimTime clockTime = 0;
+
+    void advanceInversionClock(SimTime now) {
+        if (runningCount > 0 && now > clockTime) {
+            size_t lowestRunning = runningRanks.lowerBound(runningCount) - 1;
+            inversionClock.add(0, now - clockTime);
+            inversionClock.add(lowestRunning, clockTime - now);
+        }
+        clockTime = now;
+    }
+
+    int enqueue(SchedulingPolicy &policy, size_t index, int lastCore, SimTime now) {
+        if (inversions) readyClock[index] = inversionClock.prefix(priorityRank[index] + 1);
+        return policy.enqueue(index, lastCore, now);
+    }
+
+    void releaseNextArrival() {
+        if (nextArrival < arrivalOrder.size()) {
+            size_t index = arrivalOrder[nextArrival++];
+            events.push(processes.arrivalTime[index], EventType::Arrival, index);
+        }
+    }
+
+    void markReady(int core) {
+        if (core < 0) {
+            sharedWork = true;
+        } else if (!pendingFlag[core]) {
+            pendingFlag[core] = 1;
+            pendingCores.push_back(core);
+        }
+    }
+
+    const CoreClass &classOf(int core) const { return platform.classes[platform.classOf[core]]; }
+
+    double busyWatts(int core, int frequency) const {
+        return classOf(core).activeWatts * (scaleFrequency ? dvfs.busyShare(frequency) : 1.0);
+    }
+
+    // Time core needs to finish index at its speed and the given frequency level.
+    SimTime timeAt(int core, size_t index, int frequency) const {
+        if (!scaledSpeeds) return result.remainingTime[index];
+        SimTime rate = static_cast<SimTime>(classOf(core).speed) * frequency;
+        return (static_cast<SimTime>(result.remainingTime[index]) * 10000 - partialWork[index] + rate - 1) / rate;
+    }
+
+    SimTime timeFor(int core, size_t index) const { return timeAt(core, index, level[core]); }
+
+    // Energy core draws over an idle gap of the given length, and the delay waking from it adds.
+    double idleGap(int core, SimTime gap, SimTime &wakeDelay) const {
+        const CoreClass &kind = classOf(core);
+        double energy = 0, watts = kind.idleWatts;
+        SimTime at = 0;
+        wakeDelay = 0;
+        for (const IdleState &state : idle.states) {
+            SimTime enter = std::max(at, state.targetResidency);
+            if (enter >= gap) break;
+            SimTime entered = std::min(gap, enter + state.entryLatency);
+            energy += (enter - at) * watts + (entered - enter) * kind.activeWatts;
+            wakeDelay = enter + state.entryLatency - entered + state.exitLatency;
+            at = entered;
+            watts = state.watts;
+        }
+        return energy + (gap - at) * watts;
+    }
+
+    void stopSlice(SchedulingPolicy &policy, int core, SimTime now) {
+        size_t index = running[core];
+        SimTime ran = std::max<SimTime>(0, now - sliceStart[core]);
+        if (scaledSpeeds) {
+            SimTime done = ran * classOf(core).speed * level[core] + partialWork[index];
+            SimTime work = std::min<SimTime>(done / 10000, result.remainingTime[index]);
+            partialWork[index] = work < result.remainingTime[index] ? static_cast<int>(done % 10000) : 0;
+            result.remainingTime[index] -= static_cast<int32_t>(work);
+            runTime[index] += ran;
+        } else {
+            result.remainingTime[index] -= static_cast<int32_t>(ran);
+        }
+        double watts = busyWatts(core, level[core]);
+        result.energy[index] += ran * watts;
+        result.coreBusyTime[core] += now - busySince[core];
+        result.coreEnergy[core] += (now - busySince[core]) * watts;
+        frequencyTime += static_cast<double>(now - busySince[core]) * level[core];
+        running[core] = kIdle;
+        if (costs.active()) stoppedAt[index] = now;
+        if (inversions) {
+            runningRanks.add(priorityRank[index], -1);
+            runningCount--;
+        }
+        policy.release(core, now);
+        idleCores.push(core, now);
+        idleSince[core] = now;
+        if (consolidate) recentlyIdle.push(core, -now);
+        markReady(core);
+    }
+
+    void preempt(SchedulingPolicy &policy, int core, SimTime now) {
+        size_t index = running[core];
+        if (result.recordGantt) ganttCharts[core].truncate(now);
+        sliceEvent[core] = kNoSlice;
+        stopSlice(policy, core, now);
+        markReady(enqueue(policy, index, core, now));
+    }
+
+    void complete(size_t index, SimTime now) {
+        finished[index] = 1;
+        result.turnaroundTime[index] = static_cast<int32_t>(now - processes.arrivalTime[index]);
+        result.waitingTime[index] =
+            result.turnaroundTime[index] - static_cast<int32_t>(scaledSpeeds ? runTime[index] : processes.burstTime[index]);
+        PriorityBand &band = metrics.priorityBands[PriorityBand::of(processes.priority[index])];
+        band.waitingTimes.record(result.waitingTime[index]);
+        metrics.turnaroundTimes.record(result.turnaroundTime[index]);
+        makespan = std::max(makespan, now);
+    }
+
+    void firstDispatch(size_t index, SimTime begin) {
+        if (result.responseTime[index] >= 0) return;
+        result.responseTime[index] = static_cast<int32_t>(begin - processes.arrivalTime[index]);
+        metrics.responseTimes.record(result.responseTime[index]);
+    }
+
+    // Only runs without idle states fast-forward, so the gap before the cycle costs idle power and no wakeup.
+    SimTime applyFastForward(int core, SimTime now) {
+        SimTime wakeDelay;
+        result.coreEnergy[core] += idleGap(core, now - idleSince[core], wakeDelay);
+        batchIds.clear();
+        for (size_t i = 0; i < batch.processes.size(); ++i) firstDispatch(batch.processes[i], now + batch.slice * i);
+        for (size_t index : batch.processes) {
+            result.remainingTime[index] -= static_cast<int32_t>(batch.slice * batch.rounds);
+            result.energy[index] += batch.slice * batch.rounds * busyWatts(core, level[core]);
+            batchIds.push_back(processes.id[index]);
+        }
+        if (result.recordGantt) ganttCharts[core].appendCycle(batchIds, now, batch.slice, batch.rounds);
+        // Within the cycle every slice but the first switches, unless a lone process just keeps running.
+        long long switches = lastRun[core] != kIdle && lastRun[core] != batch.processes.front() ? 1 : 0;
+        if (batch.processes.size() > 1) switches += batch.rounds * static_cast<SimTime>(batch.processes.size()) - 1;
+        metrics.contextSwitches += switches;
+        result.coreSwitches[core] += switches;
+        lastRun[core] = batch.processes.back();
+        SimTime length = batch.slice * batch.rounds * static_cast<SimTime>(batch.processes.size());
+        result.coreBusyTime[core] += length;
+        result.coreEnergy[core] += length * busyWatts(core, level[core]);
+        frequencyTime += static_cast<double>(length) * level[core];
+        idleSince[core] = now + length;
+        return now + length;
+    }
+
+    // Time lost to the cost model before index can run on core, which it last ran on previousCore.
+    SimTime switchCost(int core, size_t index, int previousCore, SimTime now) {
+        SimTime cost = 0;
+        if (lastRun[core] != kIdle && lastRun[core] != index) {
+            cost += costs.contextSwitchCost;
+            metrics.switchOverhead += costs.contextSwitchCost;
+        }
+        SimTime refill = 0;
+        if (previousCore >= 0 && previousCore != core) {
+            CpuTopology::Distance distance = topology ? topology->distance(previousCore, core)
+                                                      : CpuTopology::SharedCache;
+            if (distance != CpuTopology::SmtSibling) refill = costs.migrationPenalty;
+            if (distance >= CpuTopology::SameSocket) refill += costs.llcPenalty;
+        } else if (previousCore == core && lastRun[core] != index) {
+            refill = costs.refillPenalty(now - stoppedAt[index]);
+        }
+        metrics.migrationOverhead += refill;
+        if (topology) {
+            if (homeSocket[index] < 0) homeSocket[index] = topology->socket(core);
+            if (homeSocket[index] != topology->socket(core)) {
+                cost += costs.remoteNumaPenalty;
+                metrics.numaOverhead += costs.remoteNumaPenalty;
+            }
+        }
+        return cost + refill;
+    }
+
+    // The process runs from now plus the policy's dispatch delay and any switch costs; the core is taken from now.
+    void startSlice(SchedulingPolicy &policy, int core, size_t index, SimTime now) {
+        if (scaleFrequency) level[core] = frequencyFor(policy, core, index, now);
+        SimTime needed = timeFor(core, index);
+        SimTime length = policy.sliceFor(core, needed);
+        int previousCore = result.coreId[index];
+        SimTime begin = now + policy.dispatchDelay(core);
+        if (costs.active()) begin += switchCost(core, index, previousCore, now);
+        SimTime wakeDelay;
+        result.coreEnergy[core] += idleGap(core, now - idleSince[core], wakeDelay);
+        if (wakeDelay > 0) {
+            begin += wakeDelay;
+            metrics.wakeups++;
+            metrics.wakeupLatency += wakeDelay;
+            result.coreWakeups[core]++;
+        }
+        if (consolidate) recentlyIdle.erase(core);
+        policy.started(core, begin, length);
+        firstDispatch(index, begin);
+        if (result.recordGantt) ganttCharts[core].append(processes.id[index], begin, length);
+        result.coreId[index] = core;
+        if (lastRun[core] != kIdle && lastRun[core] != index) {
+            metrics.contextSwitches++;
+            result.coreSwitches[core]++;
+        }
+        if (previousCore >= 0 && previousCore != core) {
+            metrics.migrations++;
+            result.coreMigrations[core]++;
+        }
+        lastRun[core] = index;
+        busySince[core] = now;
+        sliceStart[core] = begin;
+        sliceEnd[core] = begin + length;
+        running[core] = index;
+        sliceEvent[core] = events.push(begin + length,
+                                       length >= needed ? EventType::Completion : EventType::QuantumExpiry, index,
+                                       core);
+        if (inversions) {
+            SimTime waited = inversionClock.prefix(priorityRank[index] + 1) - readyClock[index];
+            if (waited > 0) {
+                metrics.priorityInversionTime += waited;
+                if (!inverted[index]) metrics.priorityInversions++;
+                inverted[index] = 1;
+            }
+            runningRanks.add(priorityRank[index], 1);
+            runningCount++;
+        }
+    }
+
+    // The frequency level that runs index on core for the least energy over idling while it still meets its
+    // deadline. Looking ahead, when no other core is idle the earliest-deadline queued process must also still
+    // meet its deadline at full speed after index. If no level qualifies, full speed.
+    int frequencyFor(const SchedulingPolicy &policy, int core, size_t index, SimTime now) const {
+        SimTime deadline = DeadlineOrder::absoluteDeadline(processes, index);
+        size_t next;
+        bool lookAhead = idleCores.empty() && policy.peek(next);
+        SimTime nextDeadline = lookAhead ? DeadlineOrder::absoluteDeadline(processes, next) : 0;
+        SimTime nextTime = lookAhead ? timeAt(core, next, 100) : 0;
+        int best = 100;
+        double bestEnergy = std::numeric_limits<double>::max();
+        for (int frequency : dvfs.levels) {
+            SimTime time = timeAt(core, index, frequency);
+            if (now + time > deadline || (lookAhead && now + time + nextTime > nextDeadline)) continue;
+            double energy = time * (busyWatts(core, frequency) - classOf(core).idleWatts);
+            if (energy < bestEnergy) {
+                best = frequency;
+                bestEnergy = energy;
+            }
+        }
+        return best;
+    }
+
+    // Of the classes with an idle core, the one that finishes index on the least extra energy over idling;
+    // with deadline placement only classes that still meet its deadline qualify, and if none does, the fastest.
+    int energyAwareCore(size_t index, SimTime now) const {
+        SimTime deadline = DeadlineOrder::absoluteDeadline(processes, index);
+        int best = -1, fastest = -1;
+        double bestEnergy = 0;
+        for (size_t group = 0; group < platform.classes.size(); ++group) {
+            if (idleCores.groupEmpty(static_cast<int>(group))) continue;
+            int core = idleCores.topOf(static_cast<int>(group));
+            const CoreClass &kind = platform.classes[group];
+            SimTime time = timeAt(core, index, 100);
+            if (fastest < 0 || kind.speed > classOf(fastest).speed) fastest = core;
+            if (deadlinePlacement && now + time > deadline) continue;
+            double energy = time * (kind.activeWatts - kind.idleWatts);
+            if (best < 0 || energy < bestEnergy || (energy == bestEnergy && kind.speed > classOf(best).speed)) {
+                best = core;
+                bestEnergy = energy;
+            }
+        }
+        return best >= 0 ? best : fastest;
+    }
+
+    // The idle core a shared-queue pick should run on: the longest idle one, unless energy-aware placement picks
+    // a class for the next process or a topology places a core nearer the one it last ran on.
+    int chooseIdleCore(const SchedulingPolicy &policy, SimTime now) const {
+        size_t next;
+        if (consolidate) return recentlyIdle.top();
+        if (energyPlacement && policy.peek(next)) return energyAwareCore(next, now);
+        if (topology && policy.peek(next) && result.coreId[next] >= 0) {
+            int core = topology->nearest(result.coreId[next], numCores,
+                                         [this](int candidate) { return idleCores.contains(candidate); });
+            if (core >= 0) return core;
+        }
+        return idleCores.top();
+    }
+
+    void dispatch(SchedulingPolicy &policy, SimTime now) {
+        size_t index;
+        while (true) {
+            while (sharedWork && !idleCores.empty()) {
+                int core = chooseIdleCore(policy, now);
+                if (!policy.pick(core, now, index)) {
+                    sharedWork = false;
+                    break;
+                }
+                idleCores.erase(core);
+                startSlice(policy, core, index, now);
+            }
+            if (!sharedWork) break;
+            int victim = policy.preemptionTarget(-1, now);
+            if (victim < 0 || running[victim] == kIdle || sliceEnd[victim] <= now) break;
+            preempt(policy, victim, now);
+        }
+        for (int core : pendingCores) {
+            pendingFlag[core] = 0;
+            if (!idleCores.contains(core)) continue;
+            // Fast-forwarded rounds assume back-to-back full-speed slices, which switch costs and wakeups from idle
+            // states would space out.
+            SimTime start = !costs.active() && !scaledSpeeds && idle.states.empty() && policy.fastForward(core, now, batch)
+                                ? applyFastForward(core, now)
+                                : now;
+            if (policy.pick(core, start, index)) {
+                idleCores.erase(core);
+                startSlice(policy, core, index, start);
+            }
+        }
+        pendingCores.clear();
+    }
+
+public:
+    // platform must describe at least run.numCores cores.
+    EventSimulator(const ProcessTable &procs, const std::vector<size_t> &order, ScheduleResult &run,
+                   const CorePlatform &cores)
+        : processes(procs), result(run), ganttCharts(run.ganttCharts), metrics(run.metrics), numCores(run.numCores),
+          platform(cores),
+          idleCores(std::vector<int>(cores.classOf.begin(), cores.classOf.begin() + run.numCores),
+                    static_cast<int>(cores.classes.size())),
+          arrivalOrder(order), sliceStart(run.numCores, 0),
+          finished(procs.size(), 0), pendingFlag(run.numCores, 0), lastRun(run.numCores, kIdle),
+          busySince(run.numCores, 0), level(run.numCores, 100), idleSince(run.numCores, 0),
+          running(run.numCores, kIdle),
+          sliceEnd(run.numCores, 0), sliceEvent(run.numCores, kNoSlice) {
+        for (int core = 0; core < numCores; ++core)
+            if (classOf(core).speed != 100) scaledSpeeds = true;
+        if (scaledSpeeds) {
+            partialWork.assign(procs.size(), 0);
+            runTime.assign(procs.size(), 0);
+        }
+    }
+
+    // Shared-queue picks go to the class that runs the next process on the least energy, meeting its deadline
+    // too when meetDeadlines is set.
+    void placeForEnergy(bool meetDeadlines) {
+        energyPlacement = true;
+        deadlinePlacement = meetDeadlines;
+    }
+
+    void useIdleStates(const IdleStateConfig &config) { idle = config; }
+
+    void measureFairness(const FairnessConfig &config) { fairness = config; }
+
+    // Packs shared-queue work onto as few cores as it can so the rest stay in deep idle states.
+    void consolidateWork() {
+        consolidate = true;
+        recentlyIdle.reset(numCores);
+    }
+
+    // Each slice runs at the frequency level from frequencyFor rather than at full speed.
+    void scaleFrequencies(const DvfsConfig &config) {
+        dvfs = config;
+        scaleFrequency = true;
+        if (!scaledSpeeds && *std::min_element(dvfs.levels.begin(), dvfs.levels.end()) < 100) {
+            scaledSpeeds = true;
+            partialWork.assign(processes.size(), 0);
+            runTime.assign(processes.size(), 0);
+        }
+    }
+
+    void applySwitchCosts(const SwitchCostModel &model) {
+        costs = model;
+        if (costs.active()) stoppedAt.assign(processes.size(), 0);
+    }
+
+    void useTopology(const CpuTopology *cpus) {
+        topology = cpus;
+        if (topology) homeSocket.assign(processes.size(), -1);
+    }
+
+    // Enables inversion accounting; priorityOrder lists the processes by ascending priority value.
+    void trackPriorityInversion(const std::vector<size_t> &priorityOrder) {
+        inversions = true;
+        result.tracksPriorityInversion = true;
+        priorityRank.assign(processes.size(), 0);
+        int32_t rank = -1;
+        for (size_t i = 0; i < priorityOrder.size(); ++i) {
+            if (i == 0 || processes.priority[priorityOrder[i]] != processes.priority[priorityOrder[i - 1]]) ++rank;
+            priorityRank[priorityOrder[i]] = rank;
+        }
+        runningRanks.reset(rank + 1);
+        inversionClock.reset(rank + 1);
+        readyClock.assign(processes.size(), 0);
+        inverted.assign(processes.size(), 0);
+    }
+
+    void run(SchedulingPolicy &policy) {
+        releaseNextArrival();
+        while (!events.empty()) {
+            SimTime now = events.top().time;
+            if (inversions) advanceInversionClock(now);
+            while (!events.empty() && events.top().time == now) {
+                Event event = events.top();
+                events.pop();
+                switch (event.type) {
+                    case EventType::Arrival: {
+                        int32_t deadline = processes.deadline[event.process];
+                        releaseNextArrival();
+                        if (policy.tracksDeadlines() && deadline > 0)
+                            events.push(now + deadline, EventType::DeadlineCheck, event.process);
+                        int core = enqueue(policy, event.process, -1, now);
+                        markReady(core);
+                        int victim = core >= 0 ? policy.preemptionTarget(core, now) : -1;
+                        if (victim >= 0 && running[victim] != kIdle && sliceEnd[victim] > now)
+                            preempt(policy, victim, now);
+                        break;
+                    }
+                    case EventType::Completion:
+                        if (event.sequence != sliceEvent[event.core]) break;
+                        stopSlice(policy, event.core, now);
+                        complete(event.process, now);
+                        break;
+                    case EventType::QuantumExpiry:
+                        if (event.sequence != sliceEvent[event.core]) break;
+                        stopSlice(policy, event.core, now);
+                        markReady(enqueue(policy, event.process, event.core, now));
+                        break;
+                    case EventType::DeadlineCheck:
+                        if (!finished[event.process]) metrics.deadlineMisses++;
+                        break;
+                }
+            }
+            dispatch(policy, now);
+        }
+        // One pass over the result columns gathers every per-process aggregate.
+        double totalWaitingTime = 0, totalTurnaroundTime = 0, totalResponseTime = 0;
+        double totalSlowdown = 0, totalSquaredSlowdown = 0, totalBoundedSlowdown = 0;
+        for (size_t i = 0; i < processes.size(); ++i) {
+            int32_t waiting = result.waitingTime[i], turnaround = result.turnaroundTime[i];
+            totalWaitingTime += waiting;
+            totalTurnaroundTime += turnaround;
+            totalResponseTime += result.responseTime[i];
+            int32_t burst = std::max<int32_t>(1, processes.burstTime[i]);
+            double slowdown = static_cast<double>(turnaround) / burst;
+            totalSlowdown += slowdown;
+            totalSquaredSlowdown += slowdown * slowdown;
+            totalBoundedSlowdown +=
+                std::max(1.0, static_cast<double>(turnaround) / std::max<SimTime>(burst, fairness.slowdownBound));
+            metrics.maxSlowdown = std::max(metrics.maxSlowdown, slowdown);
+            metrics.maxWaitingTime = std::max<SimTime>(metrics.maxWaitingTime, waiting);
+            if (waiting >= fairness.starvationWait) metrics.starvedProcesses++;
+            PriorityBand &band = metrics.priorityBands[PriorityBand::of(processes.priority[i])];
+            band.processes++;
+            band.totalWaiting += waiting;
+            band.totalSlowdown += slowdown;
+            band.maxWaiting = std::max<SimTime>(band.maxWaiting, waiting);
+        }
+        // Waiting times were recorded per band; the whole run's distribution is their sum.
+        for (const PriorityBand &band : metrics.priorityBands) metrics.waitingTimes.merge(band.waitingTimes);
+        metrics.totalProcesses = processes.size();
+        if (!processes.empty()) {
+            metrics.averageWaitingTime = totalWaitingTime / processes.size();
+            metrics.averageTurnaroundTime = totalTurnaroundTime / processes.size();
+            metrics.averageResponseTime = totalResponseTime / processes.size();
+            metrics.averageSlowdown = totalSlowdown / processes.size();
+            metrics.averageBoundedSlowdown = totalBoundedSlowdown / processes.size();
+            metrics.fairnessIndex = totalSlowdown * totalSlowdown / (processes.size() * totalSquaredSlowdown);
+        }
+        SimTime busy = 0;
+        for (int core = 0; core < numCores; ++core) {
+            SimTime wakeDelay;
+            result.coreEnergy[core] += idleGap(core, std::max<SimTime>(0, makespan - idleSince[core]), wakeDelay);
+            metrics.totalPowerConsumption += result.coreEnergy[core];
+            busy += result.coreBusyTime[core];
+        }
+        if (busy > 0) metrics.averageFrequency = frequencyTime / busy;
+        metrics.calculateMetrics(numCores, makespan);
+    }
+};
+
+const size_t EventSimulator::kIdle;
+const unsigned long long EventSimulator::kNoSlice;
+
+enum class Verdict { Schedulable, Infeasible, Unknown };
+
+const char *verdictName(Verdict verdict) {
+    switch (verdict) {
+        case Verdict::Schedulable: return "schedulable";
+        case Verdict::Infeasible: return "infeasible";
+        case Verdict::Unknown: return "unknown";
+    }
+    return "";
+}
+
+struct SchedulabilityReport {
+    size_t tasks = 0;
+    double totalDensity = 0.0;
+    double maxDensity = 0.0;
+    Verdict globalEdf = Verdict::Schedulable;
+    Verdict firstFit = Verdict::Schedulable;
+    Verdict worstFit = Verdict::Schedulable;
+};
+
+// Treats every process with a deadline as a sporadic task whose jobs arrive at most once per deadline, so its
+// density burst / deadline is also its utilization. A density above 1 or a total above the core count cannot be
+// met by any scheduler. Global EDF passes the GFB bound total <= m - (m - 1) * max; partitioned EDF passes when
+// decreasing-density first-fit or worst-fit packing keeps every core at or below 1. Everything else is unknown.
+SchedulabilityReport analyzeSchedulability(const ProcessTable &processes, int numCores) {
+    const SimTime capacity = 1000000;
+    SchedulabilityReport report;
+    std::vector<SimTime> densities;
+    for (size_t i = 0; i < processes.size(); ++i) {
+        if (processes.deadline[i] <= 0) continue;
+        double density = static_cast<double>(processes.burstTime[i]) / processes.deadline[i];
+        report.totalDensity += density;
+        report.maxDensity = std::max(report.maxDensity, density);
+        densities.push_back((static_cast<SimTime>(processes.burstTime[i]) * capacity + processes.deadline[i] - 1) /
+                            processes.deadline[i]);
+    }
+    report.tasks = densities.size();
+    if (report.maxDensity > 1.0 || report.totalDensity > numCores) {
+        report.globalEdf = report.firstFit = report.worstFit = Verdict::Infeasible;
+        return report;
+    }
+    if (report.totalDensity > numCores - (numCores - 1) * report.maxDensity) report.globalEdf = Verdict::Unknown;
+
+    std::sort(densities.begin(), densities.end(), std::greater<SimTime>());
+    CoreLoadTree firstFitLoad(numCores), worstFitLoad(numCores);
+    for (SimTime density : densities) {
+        int core = firstFitLoad.firstAtMost(capacity - density);
+        if (core < 0) report.firstFit = Verdict::Unknown;
+        else firstFitLoad.set(core, firstFitLoad.load(core) + density);
+        core = worstFitLoad.firstAtMost(worstFitLoad.minimum());
+        if (worstFitLoad.load(core) + density > capacity) report.worstFit = Verdict::Unknown;
+        worstFitLoad.set(core, worstFitLoad.load(core) + density);
+    }
+    return report;
+}
+
+struct DispatchOrders {
+    std::vector<size_t> arrival;
+    std::vector<size_t> priority;
+    std::vector<size_t> deadline;
+};
+
+class EnhancedCPUScheduler {
+private:
+    ProcessTable processes;
+    int numCores;
+    FeedbackQueueConfig feedbackQueues;
+    FairSchedulerConfig fairScheduler;
+    WorkStealingConfig workStealing;
+    SwitchCostModel switchCosts;
+    std::shared_ptr<const CpuTopology> topology;
+    CorePlatform platform;
+    DvfsConfig dvfs;
+    IdleStateConfig idleStates;
+    FairnessConfig fairness;
+
+public:
+    EnhancedCPUScheduler(int cores = 4) : numCores(cores) {}
+
+    EnhancedCPUScheduler(const EnhancedCPUScheduler&) = delete;
+    EnhancedCPUScheduler& operator=(const EnhancedCPUScheduler&) = delete;
+
+    void addProcess(const Process &p) {
+        processes.push_back(p);
+    }
+
+    void clearProcesses() {
+        processes.clear();
+    }
+
+    void loadWorkload(const std::string &path) {
+        processes = loadWorkloadFile(path);
+    }
+
+    void saveWorkload(const std::string &path) const {
+        saveBinaryWorkload(processes, path);
+    }
+
+    size_t processCount() const { return processes.size(); }
+
+    int coreCount() const { return numCores; }
+
+    // Drops a CPU topology or core platform too small for the new core count.
+    void reconfigure(int newNumCores) {
+        clearProcesses();
+        numCores = newNumCores;
+        if (topology && topology->size() < static_cast<size_t>(numCores)) topology.reset();
+        if (platform.size() < static_cast<size_t>(numCores)) platform = CorePlatform();
+    }
+
+    bool isEmpty() const { return processes.empty(); }
+
+    void configureFeedbackQueues(const FeedbackQueueConfig &config) { feedbackQueues = config; }
+
+    void configureFairScheduler(const FairSchedulerConfig &config) { fairScheduler = config; }
+
+    void configureWorkStealing(const WorkStealingConfig &config) { workStealing = config; }
+
+    void configureSwitchCosts(const SwitchCostModel &model) { switchCosts = model; }
+
+    // Runs of up to the topology's size use its first cores; the interactive core count becomes its size.
+    void configureTopology(const std::shared_ptr<const CpuTopology> &cpus) {
+        topology = cpus;
+        if (topology) numCores = static_cast<int>(topology->size());
+    }
+
+    void configureIdleStates(const IdleStateConfig &config) { idleStates = config; }
+
+    void configureFairness(const FairnessConfig &config) { fairness = config; }
+
+    // Levels are sorted and 100 is added if missing.
+    void configureDvfs(const DvfsConfig &config) {
+        dvfs = config;
+        dvfs.levels.push_back(100);
+        std::sort(dvfs.levels.begin(), dvfs.levels.end());
+        dvfs.levels.erase(std::unique(dvfs.levels.begin(), dvfs.levels.end()), dvfs.levels.end());
+    }
+
+    // Like a topology, a non-empty platform sets the interactive core count and bounds every run.
+    void configureCorePlatform(const CorePlatform &cores) {
+        platform = cores;
+        if (platform.size()) numCores = static_cast<int>(platform.size());
+    }
+
+    template <typename KeyFn>
+    std::vector<size_t> sortedOrder(KeyFn key, bool tieByIndex = false) const {
+        typedef std::pair<SimTime, size_t> KeyedRow;
+        std::vector<KeyedRow> keyed(processes.size());
+        for (size_t i = 0; i < keyed.size(); ++i) keyed[i] = KeyedRow(key(i), i);
+        if (tieByIndex)
+            std::sort(keyed.begin(), keyed.end());
+        else
+            std::sort(keyed.begin(), keyed.end(),
+                      [](const KeyedRow &a, const KeyedRow &b) { return a.first < b.first; });
+        std::vector<size_t> order(keyed.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = keyed[i].second;
+        return order;
+    }
+
+    std::vector<size_t> arrivalOrder() const {
+        return sortedOrder([this](size_t i) { return processes.arrivalTime[i]; }, true);
+    }
+
+    DispatchOrders dispatchOrders() const {
+        DispatchOrders orders;
+        orders.arrival = arrivalOrder();
+        orders.priority = sortedOrder([this](size_t i) { return processes.priority[i]; });
+        orders.deadline = sortedOrder([this](size_t i) {
+            return static_cast<SimTime>(processes.arrivalTime[i]) + processes.deadline[i];
+        });
+        return orders;
+    }
+
+    ScheduleResult schedule(Algorithm algorithm, int timeQuantum, int cores, const DispatchOrders &orders,
+                            bool recordGantt = true) const {
+        ScheduleResult result(processes, cores);
+        result.algorithm = algorithm;
+        result.timeQuantum = timeQuantum;
+        result.recordGantt = recordGantt;
+        if (topology && static_cast<size_t>(cores) > topology->size())
+            throw std::invalid_argument("the CPU topology has fewer cores than the run");
+        if (platform.size() && static_cast<size_t>(cores) > platform.size())
+            throw std::invalid_argument("the core platform has fewer cores than the run");
+        CorePlatform uniform;
+        if (!platform.size()) {
+            uniform.classes.resize(1);
+            uniform.classOf.assign(cores, 0);
+        }
+        EventSimulator simulator(processes, orders.arrival, result, platform.size() ? platform : uniform);
+        simulator.applySwitchCosts(switchCosts);
+        simulator.useTopology(topology.get());
+        simulator.useIdleStates(idleStates);
+        simulator.measureFairness(fairness);
+        switch (algorithm) {
+            case Algorithm::FCFS:
+            case Algorithm::ConsolidatedFCFS: {
+                RankedPolicy policy(orders.arrival, false);
+                if (algorithm == Algorithm::ConsolidatedFCFS) simulator.consolidateWork();
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::Priority: {
+                RankedPolicy policy(orders.priority, false);
+                simulator.trackPriorityInversion(orders.priority);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::EDF: {
+                RankedPolicy policy(orders.deadline, true);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::EnergyAwareFCFS:
+            case Algorithm::EnergyAwareEDF: {
+                bool edf = algorithm == Algorithm::EnergyAwareEDF;
+                RankedPolicy policy(edf ? orders.deadline : orders.arrival, edf);
+                simulator.placeForEnergy(edf);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::DvfsEDF: {
+                RankedPolicy policy(orders.deadline, true);
+                simulator.scaleFrequencies(dvfs);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::RoundRobin:
+            case Algorithm::RoundRobinStealing: {
+                RoundRobinPolicy policy(processes, result.remainingTime, orders.arrival, cores, timeQuantum);
+                if (algorithm == Algorithm::RoundRobinStealing)
+                    policy.enableStealing(workStealing.stealCost, result.metrics, topology.get());
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::PreemptivePriority: {
+                PreemptivePriorityPolicy policy(processes, result.remainingTime, cores, timeQuantum);
+                simulator.trackPriorityInversion(orders.priority);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::GlobalEDF: {
+                GlobalEdfPolicy policy(processes, cores);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::PartitionedEDFFirstFit:
+            case Algorithm::PartitionedEDFWorstFit: {
+                PartitionedEdfPolicy policy(processes, result.remainingTime, cores,
+                                            algorithm == Algorithm::PartitionedEDFWorstFit);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::SRTF: {
+                ShortestRemainingPolicy policy(result.remainingTime, cores);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::MLFQ: {
+                FeedbackQueuePolicy policy(processes.size(), cores, timeQuantum, feedbackQueues);
+                simulator.run(policy);
+                break;
+            }
+            case Algorithm::CFS: {
+                FairSchedulerPolicy policy(processes, result.remainingTime, cores, timeQuantum, fairScheduler);
+                simulator.run(policy);
+                break;
+            }
+        }
+        return result;
+    }
+
+    ScheduleResult schedule(Algorithm algorithm, int timeQuantum = 0) const {
+        return schedule(algorithm, timeQuantum, numCores, dispatchOrders());
+    }
+
+    ScheduleResult multiCoreFCFS() const { return schedule(Algorithm::FCFS); }
+    ScheduleResult priorityScheduling() const { return schedule(Algorithm::Priority); }
+    ScheduleResult edfScheduling() const { return schedule(Algorithm::EDF); }
+    ScheduleResult consolidatedFCFS() const { return schedule(Algorithm::ConsolidatedFCFS); }
+    ScheduleResult dvfsEdfScheduling() const { return schedule(Algorithm::DvfsEDF); }
+    ScheduleResult energyAwareScheduling(bool meetDeadlines) const {
+        return schedule(meetDeadlines ? Algorithm::EnergyAwareEDF : Algorithm::EnergyAwareFCFS);
+    }
+    ScheduleResult multiCoreRoundRobin(int timeQuantum) const { return schedule(Algorithm::RoundRobin, timeQuantum); }
+    ScheduleResult workStealingRoundRobin(int timeQuantum) const {
+        return schedule(Algorithm::RoundRobinStealing, timeQuantum);
+    }
+    ScheduleResult multiLevelFeedbackQueue(int baseQuantum) const { return schedule(Algorithm::MLFQ, baseQuantum); }
+    ScheduleResult completelyFairScheduling(int targetLatency) const {
+        return schedule(Algorithm::CFS, targetLatency);
+    }
+    ScheduleResult preemptivePriorityScheduling(int agingInterval) const {
+        return schedule(Algorithm::PreemptivePriority, agingInterval);
+    }
+    ScheduleResult globalEdfScheduling() const { return schedule(Algorithm::GlobalEDF); }
+    ScheduleResult partitionedEdfScheduling(bool worstFit) const {
+        return schedule(worstFit ? Algorithm::PartitionedEDFWorstFit : Algorithm::PartitionedEDFFirstFit);
+    }
+
+    ScheduleResult shortestRemainingTimeFirst() const { return schedule(Algorithm::SRTF); }
+
+    SchedulabilityReport checkSchedulability(int cores) const { return analyzeSchedulability(processes, cores); }
+
+    void displayAllResults(const ScheduleResult &result,
+                           size_t maxProcessRows = std::numeric_limits<size_t>::max(),
+                           const GanttView &view = GanttView()) const {
+        ReportWriter out;
+        displayEnhancedMetrics(result, out, maxProcessRows);
+        displayMultiCoreGanttChart(result, out, view);
+    }
+
+    // At most maxProcessRows rows of the per-process table are written; zero leaves the table out.
+    void displayEnhancedMetrics(const ScheduleResult &result, ReportWriter &out,
+                                size_t maxProcessRows = std::numeric_limits<size_t>::max()) const {
+        const SystemMetrics &metrics = result.metrics;
+        if (maxProcessRows > 0) {
+            out.text("\n--- Process Performance ---\n");
+            out.field().text("Process").pad(10)
+               .field().text("Core").pad(8)
+               .field().text("Burst").pad(12)
+               .field().text("Priority").pad(10)
+               .field().text("Deadline").pad(12)
+               .field().text("Waiting Time").pad(15)
+               .field().text("Turnaround Time").pad(18)
+               .field().text("Response").pad(10)
+               .field().text("Energy (J)").pad(12).put('\n');
+            out.repeat('-', 110).put('\n');
+
+            size_t rows = std::min(processes.size(), maxProcessRows);
+            for (size_t i = 0; i < rows; ++i) {
+                const Process process = processes.row(i);
+                out.field().put('P').integer(process.id).pad(10)
+                   .field().integer(result.coreId[i]).pad(8)
+                   .field().integer(process.burstTime).pad(12)
+                   .field().integer(process.priority).pad(10);
+                out.field();
+                if (process.deadline > 0) out.integer(process.deadline);
+                else out.text("N/A");
+                out.pad(12)
+                   .field().integer(result.waitingTime[i]).pad(15)
+                   .field().integer(result.turnaroundTime[i]).pad(18)
+                   .field().integer(result.responseTime[i]).pad(10)
+                   .field().fixed(result.energy[i], 2).pad(12).put('\n');
+            }
+            if (rows < processes.size())
+                out.text("... ").integer(static_cast<long long>(processes.size() - rows)).text(" more processes\n");
+            out.repeat('-', 110).put('\n');
+        }
+
+        if (maxProcessRows > 0 && result.numCores > 1) {
+            out.text("\n--- Per-Core Activity ---\n");
+            out.field().text("Core").pad(8).field().text("Switches").pad(12).field().text("Migrations In").pad(14)
+               .field().text("Busy").pad(12).field().text("Energy (J)").pad(12).field().text("Wakeups").pad(10)
+               .put('\n');
+            size_t rows = std::min(static_cast<size_t>(result.numCores), maxProcessRows);
+            for (size_t core = 0; core < rows; ++core) {
+                out.field().integer(static_cast<long long>(core)).pad(8)
+                   .field().integer(result.coreSwitches[core]).pad(12)
+                   .field().integer(result.coreMigrations[core]).pad(14)
+                   .field().integer(result.coreBusyTime[core]).pad(12)
+                   .field().fixed(result.coreEnergy[core], 2).pad(12)
+                   .field().integer(result.coreWakeups[core]).pad(10).put('\n');
+            }
+            if (rows < static_cast<size_t>(result.numCores))
+                out.text("... ").integer(static_cast<long long>(result.numCores - rows)).text(" more cores\n");
+        }
+
+        if (maxProcessRows > 0 && !processes.empty()) {
+            static const char *const bandNames[PriorityBand::kCount] = {"0-63", "64-127", "128-191", "192-255"};
+            out.text("\n--- Priority Bands ---\n");
+            out.field().text("Priority").pad(10).field().text("Processes").pad(12).field().text("Avg Waiting").pad(14)
+               .field().text("P99 Waiting").pad(14).field().text("Max Waiting").pad(14)
+               .field().text("Avg Slowdown").pad(14).put('\n');
+            for (int i = 0; i < PriorityBand::kCount; ++i) {
+                const PriorityBand &band = metrics.priorityBands[i];
+                if (band.processes == 0) continue;
+                out.field().text(bandNames[i]).pad(10)
+                   .field().integer(band.processes).pad(12)
+                   .field().fixed(band.averageWaiting(), 2).pad(14)
+                   .field().integer(band.waitingTimes.quantile(0.99)).pad(14)
+                   .field().integer(band.maxWaiting).pad(14)
+                   .field().fixed(band.averageSlowdown(), 2).pad(14).put('\n');
+            }
+        }
+
+        out.text("\n--- System Performance ---\n");
+        out.text("* Number of Cores: ").integer(result.numCores).put('\n');
+        // Energy is watts times time units, so joules when a time unit is one second.
+        out.text("* Total Energy: ").fixed(metrics.totalPowerConsumption, 2).text(" J\n");
+        out.text("* Average Energy per Core: ").fixed(metrics.averagePowerPerCore, 2).text(" J\n");
+        if (result.algorithm == Algorithm::DvfsEDF)
+            out.text("* Average Frequency: ").fixed(metrics.averageFrequency, 2).text("% of full speed\n");
+        out.text("* Throughput: ").fixed(metrics.throughput, 2).text(" processes/time unit\n");
+        if (!processes.empty()) {
+            out.text("* Average Waiting Time: ").fixed(metrics.averageWaitingTime, 2).put('\n');
+            out.text("* Average Turnaround Time: ").fixed(metrics.averageTurnaroundTime, 2).put('\n');
+            out.text("* Average Response Time: ").fixed(metrics.averageResponseTime, 2).put('\n');
+            const char *names[] = {"Waiting", "Turnaround", "Response"};
+            const LatencyHistogram *latencies[] = {&metrics.waitingTimes, &metrics.turnaroundTimes,
+                                                   &metrics.responseTimes};
+            for (int i = 0; i < 3; ++i) {
+                out.text("* ").text(names[i]).text(" Time p50/p99/p99.9: ").integer(latencies[i]->quantile(0.5))
+                   .text(" / ").integer(latencies[i]->quantile(0.99)).text(" / ").integer(latencies[i]->quantile(0.999))
+                   .put('\n');
+            }
+            out.text("* Slowdown: ").fixed(metrics.averageSlowdown, 2).text(" average, ").fixed(metrics.maxSlowdown, 2)
+               .text(" max, ").fixed(metrics.averageBoundedSlowdown, 2).text(" bounded average\n");
+            out.text("* Jain Fairness Index (slowdown): ").fixed(metrics.fairnessIndex, 4).put('\n');
+            out.text("* Max Waiting Time: ").integer(metrics.maxWaitingTime).put('\n');
+        }
+        if (result.tracksPriorityInversion) {
+            out.text("* Priority Inversions: ").integer(metrics.priorityInversions).text(" processes, ")
+               .integer(metrics.priorityInversionTime).text(" time units waiting behind lower priority\n");
+        }
+        out.text("* Context Switches: ").integer(metrics.contextSwitches).put('\n');
+        out.text("* Migrations: ").integer(metrics.migrations).put('\n');
+        if (metrics.wakeups > 0) {
+            out.text("* Wakeups: ").integer(metrics.wakeups).text(" from idle states, adding ")
+               .integer(metrics.wakeupLatency).text(" time units of latency\n");
+        }
+        if (metrics.switchOverhead > 0 || metrics.migrationOverhead > 0 || metrics.numaOverhead > 0) {
+            out.text("* Switch Overhead: ").integer(metrics.switchOverhead).text(" time units switching, ")
+               .integer(metrics.migrationOverhead).text(" refilling caches, ").integer(metrics.numaOverhead)
+               .text(" on remote NUMA nodes\n");
+        }
+        if (metrics.steals > 0) {
+            out.text("* Work Stealing: ").integer(metrics.steals).text(" steals moved ")
+               .integer(metrics.stolenProcesses).text(" processes, ").integer(metrics.stealOverhead)
+               .text(" time units overhead\n");
+        }
+        if (metrics.deadlineMisses > 0) {
+            out.text("! Deadline Misses: ").integer(metrics.deadlineMisses).text(" (")
+               .fixed(100.0 * metrics.deadlineMisses / processes.size(), 2).text("%)\n");
+        } else {
+            out.text("+ All Real-time Deadlines Met!\n");
+        }
+        if (metrics.starvedProcesses > 0) {
+            out.text("! Starvation: ").integer(metrics.starvedProcesses).text(" processes waited at least ")
+               .integer(fairness.starvationWait).text(" time units\n");
+        }
+    }
+
+    // Each chart line is one pass over the track written straight into the report buffer, so huge runs
+    // render in constant memory; the view picks the window, the cores and the time units per cell.
+    void displayMultiCoreGanttChart(const ScheduleResult &result, ReportWriter &out,
+                                    const GanttView &view = GanttView()) const {
+        const SimTime scale = std::max<SimTime>(1, view.timeScale);
+        auto blockWidth = [scale](SimTime start, SimTime end) {
+            return static_cast<size_t>((end - start) / scale) * 3 + 2;
+        };
+        auto border = [&](int, SimTime start, SimTime end) { out.repeat('-', blockWidth(start, end)).put(' '); };
+
+        out.text("\n=== MULTI-CORE GANTT CHART ===\n");
+        for (int core = 0; core < result.numCores; core++) {
+            const GanttTrack &track = result.ganttCharts[core];
+            if (track.empty() || !view.showsCore(core)) continue;
+            out.text("\nCore ").integer(core).text(":\n");
+
+            out.put(' ');
+            forEachGanttBlock(track, view, border);
+            out.put('\n').put('|');
+            forEachGanttBlock(track, view, [&](int processId, SimTime start, SimTime end) {
+                size_t width = blockWidth(start, end);
+                size_t nameLength = processId < 0 ? 4 : 1 + ReportWriter::integerLength(processId);
+                size_t padding = width > nameLength ? width - nameLength : 0;
+                out.repeat(' ', padding / 2);
+                if (processId < 0) out.text("idle");
+                else out.put('P').integer(processId);
+                out.repeat(' ', padding - padding / 2).put('|');
+            });
+            out.put('\n').put(' ');
+            forEachGanttBlock(track, view, border);
+            out.put('\n').integer(view.from);
+            forEachGanttBlock(track, view, [&](int, SimTime start, SimTime end) {
+                size_t width = blockWidth(start, end) + 1, markerLength = ReportWriter::integerLength(end);
+                out.repeat(' ', width > markerLength ? width - markerLength : 0).integer(end);
+            });
+            out.put('\n');
+        }
+    }
+
+    void loadEnhancedExampleData() {
+        clearProcesses();
+        addProcess(Process(1, 10, 100, 25, false));
+        addProcess(Process(2, 5, 50, 15, true));
+        addProcess(Process(3, 8, 150, 20, false));
+        addProcess(Process(4, 3, 25, 10, true));
+        addProcess(Process(5, 12, 75, 30, false));
+        addProcess(Process(6, 6, 10, 18, true));
+    }
+
+    void inputEnhancedProcesses() {
+        int numProcesses;
+        std::cout << "Enter number of processes: ";
+        std::cin >> numProcesses;
+        clearProcesses();
+        for (int i = 0; i < numProcesses; i++) {
+            int arrivalTime, burstTime, priority, deadline;
+            char isRealTime;
+            std::cout << "\nProcess " << (i + 1) << ":" << std::endl;
+            std::cout << "Enter arrival time: "; std::cin >> arrivalTime;
+            std::cout << "Enter burst time: "; std::cin >> burstTime;
+            std::cout << "Enter priority (0-255, lower is higher): "; std::cin >> priority;
+            std::cout << "Enter deadline (0 for none): "; std::cin >> deadline;
+            std::cout << "Is real-time process? (y/n): "; std::cin >> isRealTime;
+            addProcess(Process(i + 1, burstTime, priority, deadline, (isRealTime == 'y' || isRealTime == 'Y'), arrivalTime));
+        }
+    }
+};
+
+void displayEnhancedMenu() {
+    std::cout << "\n+--------------------------------------------------+" << std::endl;
+    std::cout << "|    ENHANCED CPU SCHEDULING SIMULATOR            |" << std::endl;
+    std::cout << "+--------------------------------------------------+" << std::endl;
+    std::cout << "| 1. Input Custom Processes                       |" << std::endl;
+    std::cout << "| 2. Load Enhanced Example Data                   |" << std::endl;
+    std::cout << "| 3. Run Multi-Core FCFS Algorithm                |" << std::endl;
+    std::cout << "| 4. Run Priority-Based Scheduling                |" << std::endl;
+    std::cout << "| 5. Run EDF (Earliest Deadline First)            |" << std::endl;
+    std::cout << "| 6. Run Multi-Core Round Robin Algorithm         |" << std::endl;
+    std::cout << "| 7. Compare All Algorithms                       |" << std::endl;
+    std::cout << "| 8. Configure System (Number of Cores)           |" << std::endl;
+    std::cout << "| 9. Exit                                         |" << std::endl;
+    std::cout << "| 10. Parameter Sweep (Cores x Quanta x Policies) |" << std::endl;
+    std::cout << "| 11. Load Workload File (CSV/TSV/Binary)         |" << std::endl;
+    std::cout << "| 12. Save Workload as Binary                     |" << std::endl;
+    std::cout << "| 13. Run Preemptive Priority with Aging          |" << std::endl;
+    std::cout << "| 14. Run Global Preemptive EDF                   |" << std::endl;
+    std::cout << "| 15. Run Partitioned EDF (First/Worst-Fit)       |" << std::endl;
+    std::cout << "| 16. Check EDF Schedulability                    |" << std::endl;
+    std::cout << "| 17. Run Shortest Remaining Time First           |" << std::endl;
+    std::cout << "| 18. Run Multi-Level Feedback Queue              |" << std::endl;
+    std::cout << "| 19. Run Completely Fair Scheduler               |" << std::endl;
+    std::cout << "| 20. Run Round Robin with Work Stealing          |" << std::endl;
+    std::cout << "| 21. Configure Switch and Migration Costs        |" << std::endl;
+    std::cout << "| 22. Load CPU Topology (File/Host/Shape)         |" << std::endl;
+    std::cout << "| 23. Configure Core Classes (big.LITTLE)         |" << std::endl;
+    std::cout << "| 24. Run Energy-Aware FCFS/EDF                   |" << std::endl;
+    std::cout << "| 25. Run EDF with DVFS (P-States)                |" << std::endl;
+    std::cout << "| 26. Configure Idle States (C-States)            |" << std::endl;
+    std::cout << "| 27. Run FCFS Consolidated onto Fewest Cores     |" << std::endl;
+    std::cout << "+--------------------------------------------------+" << std::endl;
+    std::cout << "Choose an option: ";
+}
+
+// Work-stealing pool: each worker pops newest-first from its own deque and steals oldest-first from the others.
+class ThreadPool {
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable available;
+    std::atomic<size_t> pending;
+    std::atomic<size_t> nextQueue;
+    bool stopping = false;
+
+    static const ThreadPool *&currentPool() {
+        static thread_local const ThreadPool *pool = nullptr;
+        return pool;
+    }
+
+    static size_t &currentQueue() {
+        static thread_local size_t queue = 0;
+        return queue;
+    }
+
+    bool popFrom(size_t queue, bool newest, std::function<void()> &task) {
+        std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+        std::deque<std::function<void()>> &tasks = queues[queue]->tasks;
+        if (tasks.empty()) return false;
+        if (newest) {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        } else {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        return true;
+    }
+
+    bool findTask(size_t self, std::function<void()> &task) {
+        if (popFrom(self, true, task)) return true;
+        for (size_t k = 1; k < queues.size(); ++k)
+            if (popFrom((self + k) % queues.size(), false, task)) return true;
+        return false;
+    }
+
+    void workerLoop(size_t self) {
+        currentPool() = this;
+        currentQueue() = self;
+        std::function<void()> task;
+        while (true) {
+            if (findTask(self, task)) {
+                pending--;
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            available.wait(lock, [this]() { return stopping || pending > 0; });
+            if (stopping && pending == 0) return;
+        }
+    }
+
+public:
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) : pending(0), nextQueue(0) {
+        threads = std::max(1u, threads);
+        for (unsigned i = 0; i < threads; ++i) queues.emplace_back(new WorkQueue);
+        for (unsigned i = 0; i < threads; ++i)
+            workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto &worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template <typename Task>
+    std::future<typename std::result_of<Task()>::type> submit(Task task) {
+        typedef typename std::result_of<Task()>::type Result;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(task);
+        size_t queue = currentPool() == this ? currentQueue() : nextQueue++ % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+            queues[queue]->tasks.push_back([packaged]() { (*packaged)(); });
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            pending++;
+        }
+        available.notify_one();
+        return packaged->get_future();
+    }
+};
+
+// Parses "4", "1,2,8", "1-16" and geometric "1-1024:x2" (or "+k" steps) into a list of integers.
+std::vector<int> parseIntList(const std::string &spec) {
+    std::vector<int> values;
+    std::stringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        if (item.empty()) continue;
+        size_t dash = item.find('-', 1);
+        if (dash == std::string::npos) {
+            values.push_back(std::stoi(item));
+            continue;
+        }
+        size_t colon = item.find(':', dash);
+        int first = std::stoi(item.substr(0, dash));
+        int last = std::stoi(item.substr(dash + 1, colon == std::string::npos ? std::string::npos : colon - dash - 1));
+        bool geometric = false;
+        int step = 1;
+        if (colon != std::string::npos) {
+            if (colon + 2 > item.size() || (item[colon + 1] != 'x' && item[colon + 1] != '+'))
+                throw std::invalid_argument("bad step in '" + item + "'");
+            geometric = item[colon + 1] == 'x';
+            step = std::stoi(item.substr(colon + 2));
+        }
+        if (step < 1 || (geometric && (step < 2 || first < 1)))
+            throw std::invalid_argument("bad step in '" + item + "'");
+        for (long long value = first; value <= last; value = geometric ? value * step : value + step)
+            values.push_back(static_cast<int>(value));
+    }
+    if (values.empty()) throw std::invalid_argument("empty list '" + spec + "'");
+    return values;
+}
+
+// Reads a whole small text file, such as a sysfs attribute; false when it cannot be opened.
+bool readTextFile(const std::string &path, std::string &text) {
+    std::ifstream file(path.c_str());
+    if (!file) return false;
+    std::getline(file, text, '\0');
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.pop_back();
+    return true;
+}
+
+// Each online CPU in /sys/devices/system/cpu, in CPU number order. The socket is the CPU's NUMA node when the
+// kernel reports nodes, and the LLC is the highest-level cache listed for it.
+std::shared_ptr<const CpuTopology> hostCpuTopology() {
+    const std::string root = "/sys/devices/system/cpu/cpu";
+    std::map<int, int> nodeOf;
+    std::string text;
+    for (int node = 0; readTextFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", text);
+         ++node)
+        if (!text.empty())
+            for (int cpu : parseIntList(text)) nodeOf[cpu] = node;
+
+    std::shared_ptr<CpuTopology> topology(new CpuTopology);
+    struct stat info;
+    for (int cpu = 0; ::stat((root + std::to_string(cpu)).c_str(), &info) == 0; ++cpu) {
+        std::string dir = root + std::to_string(cpu), package, core;
+        if (!readTextFile(dir + "/topology/physical_package_id", package) ||
+            !readTextFile(dir + "/topology/core_id", core))
+            continue;
+        int cache = -1, cacheLevel = 0;
+        std::string level;
+        for (int index = 0; readTextFile(dir + "/cache/index" + std::to_string(index) + "/level", level); ++index) {
+            std::string id, shared;
+            std::string prefix = dir + "/cache/index" + std::to_string(index);
+            if (std::stoi(level) < cacheLevel) continue;
+            if (readTextFile(prefix + "/id", id)) cache = std::stoi(id);
+            else if (readTextFile(prefix + "/shared_cpu_list", shared)) cache = parseIntList(shared).front();
+            else continue;
+            cacheLevel = std::stoi(level);
+        }
+        auto node = nodeOf.find(cpu);
+        topology->addCore(node != nodeOf.end() ? node->second : std::stoi(package), cache, std::stoi(core));
+    }
+    if (topology->size() == 0) throw std::runtime_error("no CPU topology under /sys/devices/system/cpu");
+    return topology;
+}
+
+// "SxLxCxT": S sockets of L LLC domains of C physical cores with T SMT threads each. As Linux numbers them,
+// the first thread of every core comes before any sibling, so runs on fewer cores fill physical cores first.
+std::shared_ptr<const CpuTopology> synthesizeCpuTopology(const std::string &shape) {
+    std::vector<int> counts;
+    std::stringstream items(shape);
+    std::string item;
+    while (std::getline(items, item, 'x')) counts.push_back(std::stoi(item));
+    if (counts.size() != 4 || *std::min_element(counts.begin(), counts.end()) < 1)
+        throw std::invalid_argument("topology shape must be SOCKETSxLLCSxCORESxTHREADS");
+    std::shared_ptr<CpuTopology> topology(new CpuTopology);
+    for (int thread = 0; thread < counts[3]; ++thread)
+        for (int socket = 0; socket < counts[0]; ++socket)
+            for (int cache = 0; cache < counts[1]; ++cache)
+                for (int core = 0; core < counts[2]; ++core) topology->addCore(socket, cache, core);
+    return topology;
+}
+
+// One logical core per line, "socket llc core", separated by commas or whitespace; '#' starts a comment.
+std::shared_ptr<const CpuTopology> loadCpuTopologyFile(const std::string &path) {
+    std::ifstream file(path.c_str());
+    if (!file) throw std::runtime_error("cannot open " + path);
+    std::shared_ptr<CpuTopology> topology(new CpuTopology);
+    std::string line;
+    for (size_t number = 1; std::getline(file, line); ++number) {
+        line = line.substr(0, line.find('#'));
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        int socket, cache, core;
+        if (!(fields >> socket)) continue;
+        if (!(fields >> cache >> core)) throw std::runtime_error(path + ":" + std::to_string(number) + ": bad core");
+        topology->addCore(socket, cache, core);
+    }
+    if (topology->size() == 0) throw std::runtime_error(path + ": no cores");
+    return topology;
+}
+
+// "host" reads this machine's topology, a shape like 2x2x8x2 synthesizes one, and anything else is a file.
+std::shared_ptr<const CpuTopology> loadCpuTopology(const std::string &spec) {
+    if (spec == "host") return hostCpuTopology();
+    if (!spec.empty() && std::isdigit(static_cast<unsigned char>(spec[0])) && spec.find('x') != std::string::npos)
+        return synthesizeCpuTopology(spec);
+    return loadCpuTopologyFile(spec);
+}
+
+// Comma-separated NAME:COUNT:SPEED:ACTIVE_W:IDLE_W classes, numbered in order, e.g. big:4:100:2:0.2,little:4:50:0.5:0.05.
+CorePlatform parseCorePlatform(const std::string &spec) {
+    CorePlatform platform;
+    std::stringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        std::vector<std::string> fields;
+        std::stringstream parts(item);
+        std::string part;
+        while (std::getline(parts, part, ':')) fields.push_back(part);
+        if (fields.size() != 5) throw std::invalid_argument("core class '" + item + "' needs NAME:COUNT:SPEED:ACTIVE:IDLE");
+        CoreClass kind;
+        kind.name = fields[0];
+        int count = std::stoi(fields[1]);
+        kind.speed = std::stoi(fields[2]);
+        kind.activeWatts = std::stod(fields[3]);
+        kind.idleWatts = std::stod(fields[4]);
+        if (count < 1 || kind.speed < 1 || kind.activeWatts < 0 || kind.idleWatts < 0)
+            throw std::invalid_argument("core class '" + item + "' needs a positive count and speed and no negative power");
+        platform.classes.push_back(kind);
+        platform.classOf.insert(platform.classOf.end(), count, static_cast<int>(platform.classes.size() - 1));
+    }
+    if (platform.classes.empty()) throw std::invalid_argument("empty core class list");
+    return platform;
+}
+
+// Comma-separated NAME:WATTS:ENTRY:EXIT:RESIDENCY states, shallowest first, e.g. C1:0.05:0:1:2,C6:0.01:5:20:100.
+IdleStateConfig parseIdleStates(const std::string &spec) {
+    IdleStateConfig config;
+    std::stringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        std::vector<std::string> fields;
+        std::stringstream parts(item);
+        std::string part;
+        while (std::getline(parts, part, ':')) fields.push_back(part);
+        if (fields.size() != 5)
+            throw std::invalid_argument("idle state '" + item + "' needs NAME:WATTS:ENTRY:EXIT:RESIDENCY");
+        IdleState state;
+        state.name = fields[0];
+        state.watts = std::stod(fields[1]);
+        state.entryLatency = std::stoll(fields[2]);
+        state.exitLatency = std::stoll(fields[3]);
+        state.targetResidency = std::stoll(fields[4]);
+        if (state.watts < 0 || state.entryLatency < 0 || state.exitLatency < 0 || state.targetResidency < 0 ||
+            (!config.states.empty() && state.targetResidency <= config.states.back().targetResidency))
+            throw std::invalid_argument("idle state '" + item + "' needs non-negative values and a longer residency");
+        config.states.push_back(state);
+    }
+    if (config.states.empty()) throw std::invalid_argument("empty idle state list");
+    return config;
+}
+
+struct SweepRow {
+    Algorithm algorithm;
+    int numCores;
+    int timeQuantum;
+    SystemMetrics metrics;
+};
+
+// One row per policy and core count, and per quantum as well for policies that take a time parameter.
+std::vector<SweepRow> planParameterSweep(const std::vector<Algorithm> &algorithms, const std::vector<int> &coreCounts,
+                                         const std::vector<int> &quanta) {
+    std::vector<SweepRow> rows;
+    for (Algorithm algorithm : algorithms)
+        for (int cores : coreCounts) {
+            if (!algorithmParameter(algorithm)) {
+                rows.push_back(SweepRow{algorithm, cores, 0, SystemMetrics()});
+                continue;
+            }
+            for (int quantum : quanta) rows.push_back(SweepRow{algorithm, cores, quantum, SystemMetrics()});
+        }
+    return rows;
+}
 
-    EnhancedCPUScheduler(const EnhancedCPUScheduler&) = delete;
-    EnhancedCPUScheduler& operator=(const EnhancedCPUScheduler&) = delete;
+// Runs every planned row as its own pool task over one shared, read-only workload.
+std::vector<SweepRow> runParameterSweep(const EnhancedCPUScheduler &scheduler, ThreadPool &pool,
+                                        const std::vector<Algorithm> &algorithms, const std::vector<int> &coreCounts,
+                                        const std::vector<int> &quanta) {
+    const DispatchOrders orders = scheduler.dispatchOrders();
+    std::vector<SweepRow> rows = planParameterSweep(algorithms, coreCounts, quanta);
+    std::vector<std::future<SystemMetrics>> runs;
+    runs.reserve(rows.size());
+    for (const SweepRow &row : rows)
+        runs.push_back(pool.submit([&scheduler, &orders, row]() {
+            return scheduler.schedule(row.algorithm, row.timeQuantum, row.numCores, orders, false).metrics;
+        }));
+    for (size_t i = 0; i < rows.size(); ++i) rows[i].metrics = runs[i].get();
+    return rows;
+}
 
-    void addProcess(const Process &p) {
-        processes.push_back(p);
-    }
+enum class OutputFormat { Csv, Json, Table, Report };
 
-    void clearProcesses() {
-        processes.clear();
-        for (auto &chart : ganttCharts) chart.clear();
-        metrics = SystemMetrics();
-    }
+template <typename Visitor>
+void visitMetrics(const SystemMetrics &m, Visitor &visit) {
+    visit("makespan", m.makespan);
+    visit("throughput", m.throughput);
+    visit("avg_waiting", m.averageWaitingTime);
+    visit("avg_turnaround", m.averageTurnaroundTime);
+    visit("avg_response", m.averageResponseTime);
+    visit("p50_waiting", m.waitingTimes.quantile(0.5));
+    visit("p99_waiting", m.waitingTimes.quantile(0.99));
+    visit("p999_waiting", m.waitingTimes.quantile(0.999));
+    visit("p50_turnaround", m.turnaroundTimes.quantile(0.5));
+    visit("p99_turnaround", m.turnaroundTimes.quantile(0.99));
+    visit("p999_turnaround", m.turnaroundTimes.quantile(0.999));
+    visit("p50_response", m.responseTimes.quantile(0.5));
+    visit("p99_response", m.responseTimes.quantile(0.99));
+    visit("p999_response", m.responseTimes.quantile(0.999));
+    visit("avg_slowdown", m.averageSlowdown);
+    visit("max_slowdown", m.maxSlowdown);
+    visit("avg_bounded_slowdown", m.averageBoundedSlowdown);
+    visit("jain_fairness", m.fairnessIndex);
+    visit("max_waiting", m.maxWaitingTime);
+    visit("starved", m.starvedProcesses);
+    visit("prio0_63_waiting", m.priorityBands[0].averageWaiting());
+    visit("prio64_127_waiting", m.priorityBands[1].averageWaiting());
+    visit("prio128_191_waiting", m.priorityBands[2].averageWaiting());
+    visit("prio192_255_waiting", m.priorityBands[3].averageWaiting());
+    visit("total_power", m.totalPowerConsumption);
+    visit("power_per_core", m.averagePowerPerCore);
+    visit("deadline_misses", m.deadlineMisses);
+    visit("priority_inversions", m.priorityInversions);
+    visit("inversion_time", m.priorityInversionTime);
+    visit("context_switches", m.contextSwitches);
+    visit("steals", m.steals);
+    visit("stolen", m.stolenProcesses);
+    visit("steal_overhead", m.stealOverhead);
+    visit("migrations", m.migrations);
+    visit("switch_overhead", m.switchOverhead);
+    visit("migration_overhead", m.migrationOverhead);
+    visit("numa_overhead", m.numaOverhead);
+    visit("avg_frequency", m.averageFrequency);
+    visit("wakeups", m.wakeups);
+    visit("wakeup_latency", m.wakeupLatency);
+}
 
-    void reconfigure(int newNumCores) {
-        clearProcesses();
-        numCores = newNumCores;
-        ganttCharts.resize(numCores);
-    }
+struct MetricFormatter {
+    std::ostream &out;
+    OutputFormat format;
+    bool header;
+    bool first;
 
-    void resetProcessesState() {
-        for (auto &chart : ganttCharts) chart.clear();
-        for (auto &p : processes) {
-            p.waitingTime = 0;
-            p.turnaroundTime = 0;
-            p.remainingTime = p.burstTime;
-            p.coreId = -1;
+    void prefix(const char *name) {
+        if (format == OutputFormat::Csv) {
+            if (!first) out << ',';
+        } else if (format == OutputFormat::Json) {
+            out << (first ? "" : ",") << '"' << name << "\":";
+        } else {
+            out << ' ';
         }
-        metrics = SystemMetrics();
+        first = false;
     }
 
-    bool isEmpty() const { return processes.empty(); }
+    template <typename T>
+    void operator()(const char *name, T value) {
+        prefix(name);
+        if (format == OutputFormat::Table) out << std::setw(static_cast<int>(std::max<size_t>(std::strlen(name), 10)));
+        if (header) out << name;
+        else out << value;
+    }
+};
 
-    void multiCoreFCFS() {
-        resetProcessesState();
-        std::vector<int> coreTime(numCores, 0);
+void writeSweepRows(std::ostream &out, const std::vector<SweepRow> &rows, OutputFormat format) {
+    out << std::fixed << std::setprecision(4);
+    if (format == OutputFormat::Json) out << "{\"results\":[";
+    if (format != OutputFormat::Json) {
+        MetricFormatter columns{out, format, true, false};
+        if (format == OutputFormat::Csv) out << "policy,cores,quantum";
+        else out << std::left << std::setw(12) << "policy" << std::right << std::setw(6) << "cores" << std::setw(8) << "quantum";
+        visitMetrics(SystemMetrics(), columns);
+        out << '\n';
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const SweepRow &row = rows[i];
+        MetricFormatter values{out, format, false, false};
+        if (format == OutputFormat::Csv)
+            out << algorithmKey(row.algorithm) << ',' << row.numCores << ',' << row.timeQuantum;
+        else if (format == OutputFormat::Json)
+            out << (i ? "," : "") << "\n{\"policy\":\"" << algorithmKey(row.algorithm) << "\",\"cores\":" << row.numCores
+                << ",\"quantum\":" << row.timeQuantum;
+        else
+            out << std::left << std::setw(12) << algorithmKey(row.algorithm) << std::right << std::setw(6) << row.numCores
+                << std::setw(8) << row.timeQuantum;
+        visitMetrics(row.metrics, values);
+        out << (format == OutputFormat::Json ? "}" : "\n");
+    }
+    if (format == OutputFormat::Json) out << "\n]}\n";
+    out.flush();
+}
 
-        for (auto &proc : processes) {
-            int bestCore = std::min_element(coreTime.begin(), coreTime.end()) - coreTime.begin();
-            proc.coreId = bestCore;
-            proc.waitingTime = coreTime[bestCore];
-            proc.turnaroundTime = proc.waitingTime + proc.burstTime;
-            ganttCharts[bestCore].push_back({proc.id, proc.burstTime});
-            coreTime[bestCore] += proc.burstTime;
-            metrics.totalPowerConsumption += proc.powerConsumption;
-        }
+template <typename Pass>
+double timePass(Pass pass) {
+    auto start = std::chrono::steady_clock::now();
+    pass();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
-        int totalTime = coreTime.empty() ? 0 : *std::max_element(coreTime.begin(), coreTime.end());
-        metrics.totalProcesses = processes.size();
-        metrics.calculateMetrics(numCores, totalTime);
+// A layout micro-benchmark first: hand-written priority-order and list-scheduling passes over the same workload
+// stored as std::vector<Process> and as a ProcessTable. Then the scheduler's own order building and FCFS and
+// priority runs over that workload, which is what the simulator actually spends its time on.
+void runProcessTableBenchmark(size_t count, int numCores) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> burst(1, 100), priority(0, 255), deadline(0, 500);
+    std::vector<Process> records;
+    ProcessTable table;
+    records.reserve(count);
+    table.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Process p(static_cast<int>(i + 1), burst(rng), priority(rng), deadline(rng));
+        records.push_back(p);
+        table.push_back(p);
     }
 
-    void priorityScheduling() {
-        resetProcessesState();
-        std::vector<Process> sortedProcesses = processes;
-        std::sort(sortedProcesses.begin(), sortedProcesses.end(),
-                  [](const Process &a, const Process &b) { return a.priority < b.priority; });
+    ScheduleResult run(table, numCores);
+    std::vector<size_t> recordOrder(count), tableOrder(count);
+    double recordSort = timePass([&]() {
+        for (size_t i = 0; i < count; ++i) recordOrder[i] = i;
+        std::sort(recordOrder.begin(), recordOrder.end(),
+                  [&](size_t a, size_t b) { return records[a].priority < records[b].priority; });
+    });
+    double tableSort = timePass([&]() {
+        std::vector<std::pair<int32_t, uint32_t>> keyed(count);
+        for (size_t i = 0; i < count; ++i) keyed[i] = std::make_pair(table.priority[i], static_cast<uint32_t>(i));
+        std::sort(keyed.begin(), keyed.end(),
+                  [](const std::pair<int32_t, uint32_t> &a, const std::pair<int32_t, uint32_t> &b) {
+                      return a.first < b.first;
+                  });
+        for (size_t i = 0; i < count; ++i) tableOrder[i] = keyed[i].second;
+    });
 
-        std::vector<int> coreTime(numCores, 0);
-
-        for (auto &sorted_proc : sortedProcesses) {
-            int bestCore = std::min_element(coreTime.begin(), coreTime.end()) - coreTime.begin();
-            auto it = std::find_if(processes.begin(), processes.end(),
-                                   [&](const Process &p) { return p.id == sorted_proc.id; });
-            if (it != processes.end()) {
-                it->coreId = bestCore;
-                it->waitingTime = coreTime[bestCore];
-                it->turnaroundTime = coreTime[bestCore] + it->burstTime;
-                ganttCharts[bestCore].push_back({it->id, it->burstTime});
-                coreTime[bestCore] += it->burstTime;
-                metrics.totalPowerConsumption += it->powerConsumption;
-            }
+    long long recordChecksum = 0, tableChecksum = 0;
+    double recordPass = timePass([&]() {
+        CoreHeap cores(numCores);
+        for (size_t index : recordOrder) {
+            Process &p = records[index];
+            int core = cores.top();
+            p.remainingTime = 0;
+            p.coreId = core;
+            p.waitingTime = static_cast<int>(cores.timeOf(core));
+            p.turnaroundTime = p.waitingTime + p.burstTime;
+            cores.update(core, p.turnaroundTime);
+            recordChecksum += p.turnaroundTime;
         }
+    });
+    double tablePass = timePass([&]() {
+        CoreHeap cores(numCores);
+        for (size_t index : tableOrder) {
+            int core = cores.top();
+            run.remainingTime[index] = 0;
+            run.coreId[index] = core;
+            run.waitingTime[index] = static_cast<int32_t>(cores.timeOf(core));
+            run.turnaroundTime[index] = run.waitingTime[index] + table.burstTime[index];
+            cores.update(core, run.turnaroundTime[index]);
+            tableChecksum += run.turnaroundTime[index];
+        }
+    });
 
-        int totalTime = coreTime.empty() ? 0 : *std::max_element(coreTime.begin(), coreTime.end());
-        metrics.totalProcesses = processes.size();
-        metrics.calculateMetrics(numCores, totalTime);
-    }
+    EnhancedCPUScheduler scheduler(numCores);
+    for (const Process &p : records) scheduler.addProcess(p);
+    std::vector<size_t> priorityOrder;
+    double orderSort = timePass([&]() {
+        priorityOrder = scheduler.sortedOrder([&table](size_t i) { return table.priority[i]; });
+    });
+    DispatchOrders orders;
+    double orderBuild = timePass([&]() { orders = scheduler.dispatchOrders(); });
+    long long fcfsMakespan = 0, priorityMakespan = 0;
+    double fcfsRun = timePass([&]() {
+        fcfsMakespan = scheduler.schedule(Algorithm::FCFS, 0, numCores, orders, false).metrics.makespan;
+    });
+    double priorityRun = timePass([&]() {
+        priorityMakespan = scheduler.schedule(Algorithm::Priority, 0, numCores, orders, false).metrics.makespan;
+    });
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Processes: " << count << ", cores: " << numCores
+              << ", sizeof(Process): " << sizeof(Process) << " bytes\n";
+    std::cout << "\nLayout micro-benchmark (hand-written passes, not the scheduler's code)\n";
+    std::cout << std::left << std::setw(22) << "Pass" << std::setw(14) << "AoS (ms)"
+              << std::setw(14) << "SoA (ms)" << "Speedup\n";
+    std::cout << std::setw(22) << "Priority order" << std::setw(14) << recordSort
+              << std::setw(14) << tableSort << std::setprecision(2) << recordSort / tableSort << "x\n";
+    std::cout << std::setprecision(1) << std::setw(22) << "List schedule" << std::setw(14) << recordPass
+              << std::setw(14) << tablePass << std::setprecision(2) << recordPass / tablePass << "x\n";
+    if (recordChecksum != tableChecksum) std::cout << "! Checksum mismatch\n";
+    std::cout << "\nScheduler passes\n";
+    std::cout << std::setw(22) << "Pass" << "Time (ms)\n";
+    std::cout << std::setprecision(1) << std::setw(22) << "sortedOrder" << orderSort << '\n';
+    std::cout << std::setw(22) << "dispatchOrders" << orderBuild << '\n';
+    std::cout << std::setw(22) << "FCFS schedule" << fcfsRun << "  (makespan " << fcfsMakespan << ")\n";
+    std::cout << std::setw(22) << "Priority schedule" << priorityRun << "  (makespan " << priorityMakespan << ")\n";
+}
 
-    void edfScheduling() {
-        resetProcessesState();
-        std::vector<Process> sortedProcesses = processes;
-        std::sort(sortedProcesses.begin(), sortedProcesses.end(),
-                  [](const Process &a, const Process &b) { return a.deadline < b.deadline; });
+struct BatchOptions {
+    std::vector<std::string> workloadPaths;
+    bool exampleData = false;
+    std::vector<Algorithm> algorithms = allAlgorithms();
+    std::vector<int> coreCounts = {4};
+    std::vector<int> quanta = {4};
+    OutputFormat format = OutputFormat::Csv;
+    std::string outputPath;
+    unsigned threads = std::thread::hardware_concurrency();
+    size_t maxProcessRows = std::numeric_limits<size_t>::max();
+    bool gantt = false;
+    GanttView ganttView;
+    bool schedulabilityOnly = false;
+    FeedbackQueueConfig feedbackQueues;
+    FairSchedulerConfig fairScheduler;
+    WorkStealingConfig workStealing;
+    SwitchCostModel switchCosts;
+    std::string topology;
+    CorePlatform corePlatform;
+    DvfsConfig dvfs;
+    IdleStateConfig idleStates;
+    FairnessConfig fairness;
+    size_t benchmarkProcesses = 0;
+    int benchmarkCores = 64;
+};
 
-        std::vector<int> coreTime(numCores, 0);
+const char *kBatchUsage =
+    "Usage: cpu_scheduler [options]\n"
+    "Without options the interactive menu starts.\n"
+    "  --workload FILE      CSV/TSV or binary workload to simulate; repeat to check several task sets\n"
+    "  --example            use the built-in example workload\n"
+    "  --policies LIST      fcfs,priority,edf,rr,preemptive,gedf,pedf-ff,pedf-wf,srtf,mlfq,cfs,\n"
+    "                       rr-steal,fcfs-energy,edf-energy,edf-dvfs,fcfs-pack or all (default all)\n"
+    "  --cores LIST         core counts, e.g. 4, 1,2,8 or 1-1024:x2 (default 4)\n"
+    "  --quantum LIST       Round Robin and top MLFQ level quanta, aging intervals and CFS target latencies,\n"
+    "                       same syntax (default 4)\n"
+    "  --mlfq-levels N      MLFQ levels, each with twice the quantum of the one above (default 3, at most 32)\n"
+    "  --mlfq-quanta LIST   explicit quantum of each MLFQ level, top first; sets the number of levels\n"
+    "  --mlfq-boost N       move every MLFQ job back to the top level every N time units (default 0, never)\n"
+    "  --cfs-min-granularity N  shortest CFS slice, and the lead an arrival needs to preempt (default 1)\n"
+    "  --steal-cost N       time a rr-steal core spends taking work from another core (default 1)\n"
+    "  --switch-cost N      time a core loses switching to a different process (default 0)\n"
+    "  --migration-cost N   time to refill a cold cache after running on another core (default 0)\n"
+    "  --cache-half-life N  time for a process's cache footprint to halve while it is off its core (default 0,\n"
+    "                       never)\n"
+    "  --topology SPEC      CPU topology: a file of \"socket llc core\" lines, host, or a shape such as 2x2x8x2\n"
+    "                       (sockets x LLCs x cores x threads); runs use its first cores\n"
+    "  --llc-cost N         extra migration cost for leaving an LLC domain (default 0)\n"
+    "  --numa-cost N        cost of each slice run off a process's home NUMA node (default 0)\n"
+    "  --core-classes LIST  heterogeneous cores as NAME:COUNT:SPEED%:ACTIVE_W:IDLE_W, e.g.\n"
+    "                       big:4:100:2:0.2,little:4:50:0.5:0.05; runs use the first cores (default 100% cores\n"
+    "                       drawing 0.1 W busy, nothing idle)\n"
+    "  --dvfs-levels LIST   edf-dvfs frequency levels in percent of full speed, e.g. 25,50,75 (100 is always one)\n"
+    "  --dvfs-leakage F     share of a core's full-speed busy power that is static leakage, 0 to 1 (default 0)\n"
+    "  --idle-states LIST   C-states as NAME:WATTS:ENTRY:EXIT:RESIDENCY, shallowest first, e.g.\n"
+    "                       C1:0.05:0:1:2,C6:0.01:5:20:100 (default none: idle cores wake at once)\n"
+    "  --slowdown-bound N   shortest burst bounded slowdown divides by (default 10)\n"
+    "  --starvation-wait N  waiting time at which a process counts as starved (default 1000)\n"
+    "  --format FORMAT      csv, json, table or report (default csv)\n"
+    "  --max-rows N         report at most N rows of each per-process table; 0 leaves it out\n"
+    "  --gantt              add Gantt charts to the report\n"
+    "  --gantt-window A:B   chart only the time range [A, B)\n"
+    "  --gantt-cores LIST   chart only these cores\n"
+    "  --gantt-scale N      draw N time units per chart cell, sampling each cell at its start\n"
+    "  --schedulability     run the EDF schedulability tests on each workload instead of simulating\n"
+    "  --output FILE        write results to FILE instead of stdout\n"
+    "  --threads N          worker threads (default: hardware threads)\n"
+    "  --bench-table [N] [C] benchmark table layouts and scheduler passes over N processes on C cores\n"
+    "  --help               show this message\n";
 
-        for (auto &sorted_proc : sortedProcesses) {
-            int bestCore = std::min_element(coreTime.begin(), coreTime.end()) - coreTime.begin();
-            auto it = std::find_if(processes.begin(), processes.end(),
-                                   [&](const Process &p) { return p.id == sorted_proc.id; });
-            if (it != processes.end()) {
-                it->coreId = bestCore;
-                it->waitingTime = coreTime[bestCore];
-                it->turnaroundTime = coreTime[bestCore] + it->burstTime;
-                if (it->deadline > 0 && it->turnaroundTime > it->deadline)
-                    metrics.deadlineMisses++;
-                ganttCharts[bestCore].push_back({it->id, it->burstTime});
-                coreTime[bestCore] += it->burstTime;
-                metrics.totalPowerConsumption += it->powerConsumption;
-            }
+std::vector<Algorithm> parseAlgorithmList(const std::string &spec) {
+    const std::vector<Algorithm> &all = allAlgorithms();
+    std::vector<Algorithm> algorithms;
+    std::stringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        if (item == "all") {
+            algorithms.insert(algorithms.end(), all.begin(), all.end());
+            continue;
         }
+        auto match = std::find_if(all.begin(), all.end(),
+                                  [&](Algorithm algorithm) { return item == algorithmKey(algorithm); });
+        if (match == all.end()) throw std::invalid_argument("unknown policy '" + item + "'");
+        algorithms.push_back(*match);
+    }
+    if (algorithms.empty()) throw std::invalid_argument("empty policy list");
+    return algorithms;
+}
 
-        int totalTime = coreTime.empty() ? 0 : *std::max_element(coreTime.begin(), coreTime.end());
-        metrics.totalProcesses = processes.size();
-        metrics.calculateMetrics(numCores, totalTime);
-    }
-
-    void multiCoreRoundRobin(int timeQuantum) {
-        resetProcessesState();
-        std::vector<std::queue<Process*>> coreQueues(numCores);
-        std::vector<int> coreTime(numCores, 0);
-
-        for (size_t i = 0; i < processes.size(); i++)
-            coreQueues[i % numCores].push(&processes[i]);
-
-        bool active = true;
-        while (active) {
-            active = false;
-            for (int core = 0; core < numCores; ++core) {
-                if (!coreQueues[core].empty()) {
-                    active = true;
-                    Process *proc = coreQueues[core].front();
-                    coreQueues[core].pop();
-                    int executeTime = std::min(timeQuantum, proc->remainingTime);
-                    ganttCharts[core].push_back({proc->id, executeTime});
-                    proc->remainingTime -= executeTime;
-                    coreTime[core] += executeTime;
-                    if (proc->remainingTime > 0)
-                        coreQueues[core].push(proc);
-                    else {
-                        proc->coreId = core;
-                        proc->turnaroundTime = coreTime[core];
-                        proc->waitingTime = proc->turnaroundTime - proc->burstTime;
-                        metrics.totalPowerConsumption += proc->powerConsumption;
-                    }
-                }
-            }
+BatchOptions parseBatchOptions(int argc, char *argv[]) {
+    BatchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i], value;
+        size_t equals = flag.find('=');
+        bool inlineValue = equals != std::string::npos;
+        if (inlineValue) {
+            value = flag.substr(equals + 1);
+            flag = flag.substr(0, equals);
         }
-
-        int totalTime = coreTime.empty() ? 0 : *std::max_element(coreTime.begin(), coreTime.end());
-        metrics.totalProcesses = processes.size();
-        metrics.calculateMetrics(numCores, totalTime);
-    }
-
-    void displayAllResults() {
-        displayEnhancedMetrics();
-        displayMultiCoreGanttChart();
-    }
-
-    void displayEnhancedMetrics() {
-        std::cout << "\n--- Process Performance ---" << std::endl;
-        std::cout << std::left << std::setw(10) << "Process"
-                  << std::setw(8) << "Core"
-                  << std::setw(12) << "Burst"
-                  << std::setw(10) << "Priority"
-                  << std::setw(12) << "Deadline"
-                  << std::setw(15) << "Waiting Time"
-                  << std::setw(18) << "Turnaround Time"
-                  << std::setw(12) << "Power (W)" << std::endl;
-        std::cout << std::string(100, '-') << std::endl;
-
-        double totalWaitingTime = 0;
-        double totalTurnaroundTime = 0;
-
-        for (const auto &process : processes) {
-            std::cout << std::left << std::setw(10) << ("P" + std::to_string(process.id))
-                      << std::setw(8) << process.coreId
-                      << std::setw(12) << process.burstTime
-                      << std::setw(10) << process.priority
-                      << std::setw(12) << (process.deadline > 0 ? std::to_string(process.deadline) : "N/A")
-                      << std::setw(15) << process.waitingTime
-                      << std::setw(18) << process.turnaroundTime
-                      << std::fixed << std::setprecision(2) << std::setw(12) << process.powerConsumption << std::endl;
-            totalWaitingTime += process.waitingTime;
-            totalTurnaroundTime += process.turnaroundTime;
-        }
-        std::cout << std::string(100, '-') << std::endl;
-
-        std::cout << "\n--- System Performance ---" << std::endl;
-        std::cout << std::fixed << std::setprecision(2);
-        std::cout << "* Number of Cores: " << numCores << std::endl;
-        std::cout << "* Total Power Consumption: " << metrics.totalPowerConsumption << " W" << std::endl;
-        std::cout << "* Average Power per Core: " << metrics.averagePowerPerCore << " W" << std::endl;
-        std::cout << "* Throughput: " << metrics.throughput << " processes/time unit" << std::endl;
-        if (!processes.empty()) {
-            std::cout << "* Average Waiting Time: " << totalWaitingTime / processes.size() << std::endl;
-            std::cout << "* Average Turnaround Time: " << totalTurnaroundTime / processes.size() << std::endl;
+        auto next = [&]() -> std::string {
+            if (inlineValue) return value;
+            if (i + 1 >= argc) throw std::invalid_argument(flag + " needs a value");
+            return argv[++i];
+        };
+        if (flag == "--workload") options.workloadPaths.push_back(next());
+        else if (flag == "--example") options.exampleData = true;
+        else if (flag == "--policies") options.algorithms = parseAlgorithmList(next());
+        else if (flag == "--cores") options.coreCounts = parseIntList(next());
+        else if (flag == "--quantum") options.quanta = parseIntList(next());
+        else if (flag == "--output") options.outputPath = next();
+        else if (flag == "--max-rows") options.maxProcessRows = std::stoull(next());
+        else if (flag == "--gantt") options.gantt = true;
+        else if (flag == "--schedulability") options.schedulabilityOnly = true;
+        else if (flag == "--mlfq-levels") options.feedbackQueues.levels = std::stoi(next());
+        else if (flag == "--mlfq-quanta") options.feedbackQueues.quanta = parseIntList(next());
+        else if (flag == "--mlfq-boost") options.feedbackQueues.boostInterval = std::stoll(next());
+        else if (flag == "--cfs-min-granularity") options.fairScheduler.minGranularity = std::stoll(next());
+        else if (flag == "--steal-cost") options.workStealing.stealCost = std::stoll(next());
+        else if (flag == "--switch-cost") options.switchCosts.contextSwitchCost = std::stoll(next());
+        else if (flag == "--migration-cost") options.switchCosts.migrationPenalty = std::stoll(next());
+        else if (flag == "--cache-half-life") options.switchCosts.cacheHalfLife = std::stoll(next());
+        else if (flag == "--topology") options.topology = next();
+        else if (flag == "--llc-cost") options.switchCosts.llcPenalty = std::stoll(next());
+        else if (flag == "--numa-cost") options.switchCosts.remoteNumaPenalty = std::stoll(next());
+        else if (flag == "--core-classes") options.corePlatform = parseCorePlatform(next());
+        else if (flag == "--dvfs-levels") options.dvfs.levels = parseIntList(next());
+        else if (flag == "--dvfs-leakage") options.dvfs.leakage = std::stod(next());
+        else if (flag == "--idle-states") options.idleStates = parseIdleStates(next());
+        else if (flag == "--slowdown-bound") options.fairness.slowdownBound = std::stoll(next());
+        else if (flag == "--starvation-wait") options.fairness.starvationWait = std::stoll(next());
+        else if (flag == "--gantt-cores") options.ganttView.cores = parseIntList(next()), options.gantt = true;
+        else if (flag == "--gantt-scale") options.ganttView.timeScale = std::stoll(next()), options.gantt = true;
+        else if (flag == "--gantt-window") {
+            std::string window = next();
+            size_t colon = window.find(':');
+            if (colon == std::string::npos) throw std::invalid_argument("--gantt-window needs FROM:TO");
+            if (colon > 0) options.ganttView.from = std::stoll(window.substr(0, colon));
+            if (colon + 1 < window.size()) options.ganttView.to = std::stoll(window.substr(colon + 1));
+            options.gantt = true;
         }
-        if (metrics.deadlineMisses > 0) {
-            std::cout << "! Deadline Misses: " << metrics.deadlineMisses << " ("
-                      << (100.0 * metrics.deadlineMisses / processes.size()) << "%)" << std::endl;
+        else if (flag == "--threads") options.threads = static_cast<unsigned>(std::stoul(next()));
+        else if (flag == "--format") {
+            std::string format = next();
+            if (format == "csv") options.format = OutputFormat::Csv;
+            else if (format == "json") options.format = OutputFormat::Json;
+            else if (format == "table") options.format = OutputFormat::Table;
+            else if (format == "report") options.format = OutputFormat::Report;
+            else throw std::invalid_argument("unknown format '" + format + "'");
+        } else if (flag == "--bench-table") {
+            options.benchmarkProcesses = 10000000;
+            if (inlineValue || (i + 1 < argc && argv[i + 1][0] != '-')) options.benchmarkProcesses = std::stoul(next());
+            if (!inlineValue && i + 1 < argc && argv[i + 1][0] != '-') options.benchmarkCores = std::stoi(argv[++i]);
         } else {
-            std::cout << "+ All Real-time Deadlines Met!" << std::endl;
+            throw std::invalid_argument("unknown option '" + flag + "'");
         }
     }
+    if (*std::min_element(options.coreCounts.begin(), options.coreCounts.end()) < 1 ||
+        *std::min_element(options.quanta.begin(), options.quanta.end()) < 1)
+        throw std::invalid_argument("core counts and quanta must be positive");
+    const FeedbackQueueConfig &mlfq = options.feedbackQueues;
+    if (mlfq.levels < 1 || mlfq.levels > FeedbackQueueConfig::kMaxLevels || mlfq.boostInterval < 0 ||
+        mlfq.quanta.size() > static_cast<size_t>(FeedbackQueueConfig::kMaxLevels) ||
+        (!mlfq.quanta.empty() && *std::min_element(mlfq.quanta.begin(), mlfq.quanta.end()) < 1))
+        throw std::invalid_argument("invalid MLFQ levels, quanta or boost interval");
+    if (options.fairScheduler.minGranularity < 1)
+        throw std::invalid_argument("CFS minimum granularity must be positive");
+    if (options.workStealing.stealCost < 0) throw std::invalid_argument("steal cost must not be negative");
+    const SwitchCostModel &costs = options.switchCosts;
+    if (costs.contextSwitchCost < 0 || costs.migrationPenalty < 0 || costs.cacheHalfLife < 0 || costs.llcPenalty < 0 ||
+        costs.remoteNumaPenalty < 0)
+        throw std::invalid_argument("switch costs must not be negative");
+    const DvfsConfig &dvfs = options.dvfs;
+    if (*std::min_element(dvfs.levels.begin(), dvfs.levels.end()) < 1 ||
+        *std::max_element(dvfs.levels.begin(), dvfs.levels.end()) > 100 || !(dvfs.leakage >= 0 && dvfs.leakage <= 1))
+        throw std::invalid_argument("DVFS levels must be 1-100 and leakage 0-1");
+    if (options.fairness.slowdownBound < 1 || options.fairness.starvationWait < 0)
+        throw std::invalid_argument("slowdown bound must be positive and starvation wait not negative");
+    if (options.ganttView.timeScale < 1 || options.ganttView.from < 0 || options.ganttView.to <= options.ganttView.from)
+        throw std::invalid_argument("invalid Gantt window or scale");
+    if (options.gantt && options.format != OutputFormat::Report)
+        throw std::invalid_argument("Gantt charts need --format report");
+    if (options.benchmarkProcesses == 0 && options.workloadPaths.empty() == !options.exampleData)
+        throw std::invalid_argument("give either --workload FILE or --example");
+    if (options.workloadPaths.size() > 1 && !options.schedulabilityOnly)
+        throw std::invalid_argument("only --schedulability takes more than one workload");
+    return options;
+}
 
-    void displayMultiCoreGanttChart() {
-        std::cout << "\n=== MULTI-CORE GANTT CHART ===" << std::endl;
-        for (int core = 0; core < numCores; core++) {
-            if (ganttCharts[core].empty()) continue;
-            std::cout << "\nCore " << core << ":" << std::endl;
+struct SchedulabilityRow {
+    std::string workload;
+    int numCores;
+    SchedulabilityReport report;
+};
 
-            std::string topBorder = " ", midLayer = "|", bottomBorder = " ", timeMarkers = "0";
-            int currentTime = 0;
-            for (const auto &entry : ganttCharts[core]) {
-                int width = entry.second * 3 + 2;
-                std::string pName = "P" + std::to_string(entry.first);
-                int padding = width - pName.length();
-                topBorder += std::string(width, '-') + " ";
-                bottomBorder += std::string(width, '-') + " ";
-                midLayer += std::string(padding / 2, ' ') + pName + std::string(padding - (padding / 2), ' ') + "|";
-                currentTime += entry.second;
-                std::string timeStr = std::to_string(currentTime);
-                timeMarkers += std::string(width + 1 - timeStr.length(), ' ') + timeStr;
-            }
-            std::cout << topBorder << std::endl;
-            std::cout << midLayer << std::endl;
-            std::cout << bottomBorder << std::endl;
-            std::cout << timeMarkers << std::endl;
+void writeSchedulabilityRows(std::ostream &out, const std::vector<SchedulabilityRow> &rows, OutputFormat format) {
+    const char *columns[] = {"workload", "cores", "tasks", "total_density", "max_density", "global_edf", "partitioned_ff",
+                             "partitioned_wf"};
+    const int widths[] = {-24, 6, 8, 14, 12, 12, 15, 15};
+    const size_t count = sizeof(columns) / sizeof(columns[0]);
+    out << std::fixed << std::setprecision(4);
+    if (format == OutputFormat::Json) out << "{\"schedulability\":[";
+    else {
+        for (size_t c = 0; c < count; ++c) {
+            if (format == OutputFormat::Csv) out << (c ? "," : "") << columns[c];
+            else out << (widths[c] < 0 ? std::left : std::right) << std::setw(std::abs(widths[c])) << columns[c] << ' ';
+        }
+        out << std::right << '\n';
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const SchedulabilityReport &report = rows[i].report;
+        std::ostringstream fields[count];
+        fields[0] << rows[i].workload;
+        fields[1] << rows[i].numCores;
+        fields[2] << report.tasks;
+        fields[3] << std::fixed << std::setprecision(4) << report.totalDensity;
+        fields[4] << std::fixed << std::setprecision(4) << report.maxDensity;
+        fields[5] << verdictName(report.globalEdf);
+        fields[6] << verdictName(report.firstFit);
+        fields[7] << verdictName(report.worstFit);
+        if (format == OutputFormat::Json) out << (i ? "," : "") << "\n{";
+        for (size_t c = 0; c < count; ++c) {
+            bool quoted = c == 0 || c >= 5;
+            if (format == OutputFormat::Csv) out << (c ? "," : "") << fields[c].str();
+            else if (format == OutputFormat::Json)
+                out << (c ? "," : "") << '"' << columns[c] << "\":" << (quoted ? "\"" : "") << fields[c].str()
+                    << (quoted ? "\"" : "");
+            else
+                out << (widths[c] < 0 ? std::left : std::right) << std::setw(std::abs(widths[c])) << fields[c].str()
+                    << ' ';
         }
+        out << std::right << (format == OutputFormat::Json ? "}" : "\n");
     }
+    if (format == OutputFormat::Json) out << "\n]}\n";
+    out.flush();
+}
 
-    void loadEnhancedExampleData() {
-        clearProcesses();
-        addProcess(Process(1, 10, 100, 25, false));
-        addProcess(Process(2, 5, 50, 15, true));
-        addProcess(Process(3, 8, 150, 20, false));
-        addProcess(Process(4, 3, 25, 10, true));
-        addProcess(Process(5, 12, 75, 30, false));
-        addProcess(Process(6, 6, 10, 18, true));
+// Task sets are independent, so each is loaded and checked against every core count on its own worker.
+int runSchedulabilityCheck(const BatchOptions &options) {
+    ThreadPool pool(options.threads);
+    std::vector<std::string> workloads = options.workloadPaths;
+    if (options.exampleData) workloads.assign(1, "example");
+    std::vector<std::future<std::vector<SchedulabilityRow>>> checks;
+    for (const std::string &workload : workloads)
+        checks.push_back(pool.submit([&options, workload]() {
+            EnhancedCPUScheduler scheduler;
+            if (options.exampleData) scheduler.loadEnhancedExampleData();
+            else scheduler.loadWorkload(workload);
+            std::vector<SchedulabilityRow> rows;
+            for (int cores : options.coreCounts)
+                rows.push_back(SchedulabilityRow{workload, cores, scheduler.checkSchedulability(cores)});
+            return rows;
+        }));
+    std::vector<SchedulabilityRow> rows;
+    for (auto &check : checks) {
+        std::vector<SchedulabilityRow> part = check.get();
+        rows.insert(rows.end(), part.begin(), part.end());
+    }
+    OutputFormat format = options.format == OutputFormat::Report ? OutputFormat::Table : options.format;
+    if (options.outputPath.empty()) {
+        writeSchedulabilityRows(std::cout, rows, format);
+        return std::cout ? 0 : 1;
+    }
+    std::ofstream out(options.outputPath.c_str());
+    if (!out) throw std::runtime_error("cannot create " + options.outputPath);
+    writeSchedulabilityRows(out, rows, format);
+    return out ? 0 : 1;
+}
+
+int runBatch(const BatchOptions &options) {
+    if (options.benchmarkProcesses > 0) {
+        runProcessTableBenchmark(options.benchmarkProcesses, options.benchmarkCores);
+        return 0;
+    }
+    if (options.schedulabilityOnly) return runSchedulabilityCheck(options);
+    EnhancedCPUScheduler scheduler(options.coreCounts.front());
+    if (options.exampleData) scheduler.loadEnhancedExampleData();
+    else scheduler.loadWorkload(options.workloadPaths.front());
+    scheduler.configureFeedbackQueues(options.feedbackQueues);
+    scheduler.configureFairScheduler(options.fairScheduler);
+    scheduler.configureWorkStealing(options.workStealing);
+    scheduler.configureSwitchCosts(options.switchCosts);
+    scheduler.configureDvfs(options.dvfs);
+    scheduler.configureIdleStates(options.idleStates);
+    scheduler.configureFairness(options.fairness);
+    if (!options.topology.empty()) {
+        std::shared_ptr<const CpuTopology> topology = loadCpuTopology(options.topology);
+        if (static_cast<size_t>(*std::max_element(options.coreCounts.begin(), options.coreCounts.end())) >
+            topology->size())
+            throw std::runtime_error("the CPU topology has only " + std::to_string(topology->size()) + " cores");
+        scheduler.configureTopology(topology);
+    }
+    if (options.corePlatform.size()) {
+        if (static_cast<size_t>(*std::max_element(options.coreCounts.begin(), options.coreCounts.end())) >
+            options.corePlatform.size())
+            throw std::runtime_error("the core classes have only " + std::to_string(options.corePlatform.size()) +
+                                     " cores");
+        scheduler.configureCorePlatform(options.corePlatform);
     }
 
-    void inputEnhancedProcesses() {
-        int numProcesses;
-        std::cout << "Enter number of processes: ";
-        std::cin >> numProcesses;
-        clearProcesses();
-        for (int i = 0; i < numProcesses; i++) {
-            int burstTime, priority, deadline;
-            char isRealTime;
-            std::cout << "\nProcess " << (i + 1) << ":" << std::endl;
-            std::cout << "Enter burst time: "; std::cin >> burstTime;
-            std::cout << "Enter priority (0-255, lower is higher): "; std::cin >> priority;
-            std::cout << "Enter deadline (0 for none): "; std::cin >> deadline;
-            std::cout << "Is real-time process? (y/n): "; std::cin >> isRealTime;
-            addProcess(Process(i + 1, burstTime, priority, deadline, (isRealTime == 'y' || isRealTime == 'Y')));
+    if (options.format == OutputFormat::Report) {
+        std::unique_ptr<ReportWriter> out(options.outputPath.empty() ? new ReportWriter()
+                                                                     : new ReportWriter(options.outputPath));
+        const DispatchOrders orders = scheduler.dispatchOrders();
+        for (const SweepRow &run : planParameterSweep(options.algorithms, options.coreCounts, options.quanta)) {
+            ScheduleResult result =
+                scheduler.schedule(run.algorithm, run.timeQuantum, run.numCores, orders, options.gantt);
+            out->text("\n=== ").text(algorithmName(run.algorithm)).text(" on ").integer(run.numCores).text(" cores");
+            if (algorithmParameter(run.algorithm))
+                out->text(", ").text(algorithmParameter(run.algorithm)).put(' ').integer(run.timeQuantum);
+            out->text(" ===\n");
+            scheduler.displayEnhancedMetrics(result, *out, options.maxProcessRows);
+            if (options.gantt) scheduler.displayMultiCoreGanttChart(result, *out, options.ganttView);
         }
+        out->flush();
+        return out->good() ? 0 : 1;
     }
-};
 
-void displayEnhancedMenu() {
-    std::cout << "\n+--------------------------------------------------+" << std::endl;
-    std::cout << "|    ENHANCED CPU SCHEDULING SIMULATOR            |" << std::endl;
-    std::cout << "+--------------------------------------------------+" << std::endl;
-    std::cout << "| 1. Input Custom Processes                       |" << std::endl;
-    std::cout << "| 2. Load Enhanced Example Data                   |" << std::endl;
-    std::cout << "| 3. Run Multi-Core FCFS Algorithm                |" << std::endl;
-    std::cout << "| 4. Run Priority-Based Scheduling                |" << std::endl;
-    std::cout << "| 5. Run EDF (Earliest Deadline First)            |" << std::endl;
-    std::cout << "| 6. Run Multi-Core Round Robin Algorithm         |" << std::endl;
-    std::cout << "| 7. Compare All Algorithms                       |" << std::endl;
-    std::cout << "| 8. Configure System (Number of Cores)           |" << std::endl;
-    std::cout << "| 9. Exit                                         |" << std::endl;
-    std::cout << "+--------------------------------------------------+" << std::endl;
-    std::cout << "Choose an option: ";
+    ThreadPool pool(options.threads);
+    std::vector<SweepRow> rows =
+        runParameterSweep(scheduler, pool, options.algorithms, options.coreCounts, options.quanta);
+    if (options.outputPath.empty()) {
+        writeSweepRows(std::cout, rows, options.format);
+        return std::cout ? 0 : 1;
+    }
+    std::ofstream out(options.outputPath.c_str());
+    if (!out) throw std::runtime_error("cannot create " + options.outputPath);
+    writeSweepRows(out, rows, options.format);
+    return out ? 0 : 1;
 }
 
-void runAndDisplay(EnhancedCPUScheduler &scheduler, int algo, int timeQuantum = 0) {
+void runAndDisplay(const EnhancedCPUScheduler &scheduler, int algo, int timeQuantum = 0) {
     if (scheduler.isEmpty()) {
         std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
         return;
     }
     switch (algo) {
-        case 3: scheduler.multiCoreFCFS(); break;
-        case 4: scheduler.priorityScheduling(); break;
-        case 5: scheduler.edfScheduling(); break;
-        case 6: scheduler.multiCoreRoundRobin(timeQuantum); break;
+        case 3: scheduler.displayAllResults(scheduler.multiCoreFCFS()); break;
+        case 4: scheduler.displayAllResults(scheduler.priorityScheduling()); break;
+        case 5: scheduler.displayAllResults(scheduler.edfScheduling()); break;
+        case 6: scheduler.displayAllResults(scheduler.multiCoreRoundRobin(timeQuantum)); break;
+        case 13: scheduler.displayAllResults(scheduler.preemptivePriorityScheduling(timeQuantum)); break;
+        case 14: scheduler.displayAllResults(scheduler.globalEdfScheduling()); break;
+        case 17: scheduler.displayAllResults(scheduler.shortestRemainingTimeFirst()); break;
+        case 18: scheduler.displayAllResults(scheduler.multiLevelFeedbackQueue(timeQuantum)); break;
+        case 19: scheduler.displayAllResults(scheduler.completelyFairScheduling(timeQuantum)); break;
+        case 20: scheduler.displayAllResults(scheduler.workStealingRoundRobin(timeQuantum)); break;
+        case 25: scheduler.displayAllResults(scheduler.dvfsEdfScheduling()); break;
+        case 27: scheduler.displayAllResults(scheduler.consolidatedFCFS()); break;
     }
-    scheduler.displayAllResults();
+}
+
+// Every policy runs on its own ScheduleResult against the shared, read-only workload; results print in menu order.
+void compareAllAlgorithms(const EnhancedCPUScheduler &scheduler, ThreadPool &pool, int timeQuantum) {
+    std::vector<std::future<ScheduleResult>> runs;
+    for (Algorithm algorithm : allAlgorithms())
+        runs.push_back(pool.submit([&scheduler, algorithm, timeQuantum]() {
+            return scheduler.schedule(algorithm, timeQuantum);
+        }));
+    for (auto &run : runs) scheduler.displayAllResults(run.get());
 }
 
 
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1)
+    {
+        std::ios::sync_with_stdio(false);
+        BatchOptions options;
+        try
+        {
+            if (std::string(argv[1]) == "--help")
+            {
+                std::cout << kBatchUsage;
+                return 0;
+            }
+            options = parseBatchOptions(argc, argv);
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << "cpu_scheduler: " << error.what() << '\n' << kBatchUsage;
+            return 2;
+        }
+        try
+        {
+            return runBatch(options);
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << "cpu_scheduler: " << error.what() << '\n';
+            return 1;
+        }
+    }
+
     EnhancedCPUScheduler scheduler(4); // Default to 4 cores
+    ThreadPool pool;
     int choice;
 
     std::cout << "Welcome to the Enhanced CPU Scheduling Simulator!" << std::endl;
@@ -382,14 +4416,17 @@ int main()
             break;
         }
         case 7:
-            runAndDisplay(scheduler, 3);
-            runAndDisplay(scheduler, 4);
-            runAndDisplay(scheduler, 5);
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
             {
                 int tq;
-                std::cout << "\nEnter time quantum for Round Robin comparison: ";
+                std::cout << "\nEnter the time parameter shared by the comparison: the Round Robin and work-stealing\n"
+                          << "quantum, the MLFQ top-level quantum, the aging interval and the CFS target latency: ";
                 std::cin >> tq;
-                runAndDisplay(scheduler, 6, tq);
+                compareAllAlgorithms(scheduler, pool, tq);
             }
             break;
         case 8:
@@ -411,6 +4448,316 @@ int main()
         case 9:
             std::cout << "Thank you for using the simulator!" << std::endl;
             return 0;
+        case 10:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                std::string coreSpec, quantumSpec;
+                std::cout << "Enter core counts (e.g. 1-16 or 1-1024:x2): ";
+                std::cin >> coreSpec;
+                std::cout << "Enter quanta, aging intervals and CFS target latencies (e.g. 4 or 1-512:x2): ";
+                std::cin >> quantumSpec;
+                try
+                {
+                    std::vector<int> coreCounts = parseIntList(coreSpec), quanta = parseIntList(quantumSpec);
+                    if (*std::min_element(coreCounts.begin(), coreCounts.end()) < 1 ||
+                        *std::min_element(quanta.begin(), quanta.end()) < 1)
+                        throw std::invalid_argument("values must be positive");
+                    std::cout << std::endl;
+                    writeSweepRows(std::cout, runParameterSweep(scheduler, pool, allAlgorithms(), coreCounts, quanta),
+                                   OutputFormat::Csv);
+                }
+                catch (const std::exception &error)
+                {
+                    std::cout << "\nInvalid sweep specification: " << error.what() << std::endl;
+                }
+            }
+            break;
+        case 11:
+        {
+            std::string path;
+            std::cout << "Enter workload file path: ";
+            std::cin >> path;
+            try
+            {
+                scheduler.loadWorkload(path);
+                std::cout << "\nLoaded " << scheduler.processCount() << " processes from " << path << std::endl;
+            }
+            catch (const std::exception &error)
+            {
+                std::cout << "\nCould not load workload: " << error.what() << std::endl;
+            }
+            break;
+        }
+        case 12:
+        {
+            std::string path;
+            std::cout << "Enter output file path: ";
+            std::cin >> path;
+            try
+            {
+                scheduler.saveWorkload(path);
+                std::cout << "\nSaved " << scheduler.processCount() << " processes to " << path << std::endl;
+            }
+            catch (const std::exception &error)
+            {
+                std::cout << "\nCould not save workload: " << error.what() << std::endl;
+            }
+            break;
+        }
+        case 13:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                int agingInterval;
+                std::cout << "Enter aging interval (0 disables aging): ";
+                std::cin >> agingInterval;
+                runAndDisplay(scheduler, choice, agingInterval);
+            }
+            break;
+        case 14:
+        case 17:
+            runAndDisplay(scheduler, choice);
+            break;
+        case 15:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                int placement;
+                std::cout << "Placement (1 = first-fit, 2 = worst-fit): ";
+                std::cin >> placement;
+                if (placement != 1 && placement != 2)
+                {
+                    std::cout << "\nInvalid placement." << std::endl;
+                    break;
+                }
+                scheduler.displayAllResults(scheduler.partitionedEdfScheduling(placement == 2));
+            }
+            break;
+        case 16:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                std::vector<SchedulabilityRow> rows;
+                for (int cores = 1; cores < scheduler.coreCount(); cores *= 2)
+                    rows.push_back(SchedulabilityRow{"current", cores, scheduler.checkSchedulability(cores)});
+                rows.push_back(SchedulabilityRow{"current", scheduler.coreCount(),
+                                                 scheduler.checkSchedulability(scheduler.coreCount())});
+                std::cout << std::endl;
+                writeSchedulabilityRows(std::cout, rows, OutputFormat::Table);
+            }
+            break;
+        case 18:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                int tq;
+                FeedbackQueueConfig config;
+                std::cout << "Enter time quantum of the top level: ";
+                std::cin >> tq;
+                std::cout << "Enter number of levels (1-32): ";
+                std::cin >> config.levels;
+                std::cout << "Enter boost interval (0 never boosts): ";
+                std::cin >> config.boostInterval;
+                if (config.levels < 1 || config.levels > FeedbackQueueConfig::kMaxLevels || config.boostInterval < 0)
+                {
+                    std::cout << "\nInvalid feedback queue settings." << std::endl;
+                    break;
+                }
+                scheduler.configureFeedbackQueues(config);
+                runAndDisplay(scheduler, choice, tq);
+            }
+            break;
+        case 19:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                int latency;
+                FairSchedulerConfig config;
+                std::cout << "Enter target latency: ";
+                std::cin >> latency;
+                std::cout << "Enter minimum granularity: ";
+                std::cin >> config.minGranularity;
+                if (config.minGranularity < 1)
+                {
+                    std::cout << "\nInvalid minimum granularity." << std::endl;
+                    break;
+                }
+                scheduler.configureFairScheduler(config);
+                runAndDisplay(scheduler, choice, latency);
+            }
+            break;
+        case 20:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                int tq;
+                WorkStealingConfig config;
+                std::cout << "Enter time quantum for Round Robin: ";
+                std::cin >> tq;
+                std::cout << "Enter steal cost: ";
+                std::cin >> config.stealCost;
+                if (config.stealCost < 0)
+                {
+                    std::cout << "\nInvalid steal cost." << std::endl;
+                    break;
+                }
+                scheduler.configureWorkStealing(config);
+                runAndDisplay(scheduler, choice, tq);
+            }
+            break;
+        case 21:
+        {
+            SwitchCostModel model;
+            std::cout << "Enter context switch cost: ";
+            std::cin >> model.contextSwitchCost;
+            std::cout << "Enter migration penalty: ";
+            std::cin >> model.migrationPenalty;
+            std::cout << "Enter cache half-life (0 never decays): ";
+            std::cin >> model.cacheHalfLife;
+            if (model.contextSwitchCost < 0 || model.migrationPenalty < 0 || model.cacheHalfLife < 0)
+            {
+                std::cout << "\nInvalid costs. Configuration unchanged." << std::endl;
+                break;
+            }
+            scheduler.configureSwitchCosts(model);
+            std::cout << "\nSwitch costs apply to every policy from now on." << std::endl;
+            break;
+        }
+        case 22:
+        {
+            std::string spec;
+            std::cout << "Enter topology file, 'host' or shape SOCKETSxLLCSxCORESxTHREADS: ";
+            std::cin >> spec;
+            try
+            {
+                std::shared_ptr<const CpuTopology> topology = loadCpuTopology(spec);
+                scheduler.configureTopology(topology);
+                std::cout << "\nSystem now has the topology's " << topology->size() << " cores." << std::endl;
+            }
+            catch (const std::exception &error)
+            {
+                std::cout << "\nCould not load topology: " << error.what() << std::endl;
+            }
+            break;
+        }
+        case 23:
+        {
+            std::string spec;
+            std::cout << "Enter core classes NAME:COUNT:SPEED%:ACTIVE_W:IDLE_W, comma-separated: ";
+            std::cin >> spec;
+            try
+            {
+                CorePlatform platform = parseCorePlatform(spec);
+                scheduler.configureCorePlatform(platform);
+                std::cout << "\nSystem now has " << platform.size() << " cores in " << platform.classes.size()
+                          << " classes." << std::endl;
+            }
+            catch (const std::exception &error)
+            {
+                std::cout << "\nCould not configure core classes: " << error.what() << std::endl;
+            }
+            break;
+        }
+        case 24:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                int order;
+                std::cout << "Order (1 = FCFS, 2 = EDF, meeting deadlines where it can): ";
+                std::cin >> order;
+                if (order != 1 && order != 2)
+                {
+                    std::cout << "\nInvalid order." << std::endl;
+                    break;
+                }
+                scheduler.displayAllResults(scheduler.energyAwareScheduling(order == 2));
+            }
+            break;
+        case 25:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                DvfsConfig config;
+                std::string levels;
+                std::cout << "Enter frequency levels in percent of full speed (e.g. 25,50,75): ";
+                std::cin >> levels;
+                std::cout << "Enter static leakage share of full-speed power (0-1): ";
+                std::cin >> config.leakage;
+                try
+                {
+                    config.levels = parseIntList(levels);
+                }
+                catch (const std::exception &)
+                {
+                    config.levels.clear();
+                }
+                if (config.levels.empty() || *std::min_element(config.levels.begin(), config.levels.end()) < 1 ||
+                    *std::max_element(config.levels.begin(), config.levels.end()) > 100 ||
+                    !(config.leakage >= 0 && config.leakage <= 1))
+                {
+                    std::cout << "\nInvalid levels or leakage." << std::endl;
+                    break;
+                }
+                scheduler.configureDvfs(config);
+                runAndDisplay(scheduler, choice);
+            }
+            break;
+        case 26:
+        {
+            std::string spec;
+            std::cout << "Enter idle states NAME:WATTS:ENTRY:EXIT:RESIDENCY, shallowest first, comma-separated: ";
+            std::cin >> spec;
+            try
+            {
+                IdleStateConfig config = parseIdleStates(spec);
+                scheduler.configureIdleStates(config);
+                std::cout << "\n" << config.states.size() << " idle states apply to every policy from now on."
+                          << std::endl;
+            }
+            catch (const std::exception &error)
+            {
+                std::cout << "\nCould not configure idle states: " << error.what() << std::endl;
+            }
+            break;
+        }
+        case 27:
+            if (scheduler.isEmpty())
+            {
+                std::cout << "\nNo processes loaded. Please use option 1 or 2 first." << std::endl;
+            }
+            else
+            {
+                runAndDisplay(scheduler, choice);
+            }
+            break;
         default:
             std::cout << "Invalid choice. Please try again." << std::endl;
         }